@@ -0,0 +1,5 @@
+#pragma once
+#include "Options.h"
+
+// Headless benchmark-ovi bez prozora i OpenGL-a (Kostur.exe --bench=ime [--bench-count=N])
+int runBenchmark(const Options& options);
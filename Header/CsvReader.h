@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Citanje "ime,skor" CSV-a u velikim blokovima (fread), bez iostream-a i bez alokacija po liniji.
+// Memorija je konstantna (jedan bafer), pa velicina fajla nije ogranicena.
+class CsvReader {
+private:
+    FILE* file;
+    std::vector<char> buffer;
+    size_t begin;                     // Pocetak neprocitanog dela bafera
+    size_t end;                       // Kraj ucitanih podataka
+    bool endOfFile;
+    long long bytesRead;
+    long long skippedLines;
+
+    bool refill();
+
+public:
+    explicit CsvReader(size_t bufferSize = 1 << 20);
+    ~CsvReader();
+
+    CsvReader(const CsvReader&) = delete;
+    CsvReader& operator=(const CsvReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    // Sledeca ispravna linija; name pokazuje u bafer (bez '\0') i vazi do sledeceg poziva
+    bool next(const char*& name, size_t& nameLength, int& score);
+
+    long long getBytesRead() const { return bytesRead; }
+    long long getSkippedLines() const { return skippedLines; }
+};
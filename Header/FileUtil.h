@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdio>
+#include <string>
+
+// Pomocne funkcije za bezbedan upis fajlova (Windows i POSIX)
+bool fileExists(const std::string& path);
+
+// Atomska zamena: "to" je posle poziva ili stari ili potpuno nov fajl
+bool replaceFile(const std::string& from, const std::string& to);
+
+// fflush + fsync - podaci stizu na disk, ne samo u bafer operativnog sistema
+void syncFile(FILE* file);
+
+// Skracuje otvoren fajl na size bajtova (odbacuje prekinut upis na kraju)
+bool truncateFile(FILE* file, long long size);
@@ -0,0 +1,46 @@
+#pragma once
+#include <chrono>
+#include <vector>
+
+// Ogranicavanje broja frejmova sa apsolutnim rokovima: rok sledeceg frejma je prethodni rok +
+// interval (ne "sada + ostatak"), pa se greske ne sabiraju. Do blizu roka se spava (sleep_for),
+// a ostatak se ceka uz yield - sleep_for zna da zakasni i vise od milisekunde, sto se vidi kao
+// trzanje bloka koji se ljulja. Prag za yield se prilagodjava izmerenom kasnjenju spavanja.
+// Usput se pravi histogram stvarnih razmaka izmedju frejmova (printReport na kraju).
+class FramePacer {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    static const int BUCKET_US = 50;
+    static const int BUCKET_COUNT = 2000;     // Do 100 ms; duzi razmaci idu u poslednju korpu
+
+    Clock::duration frameInterval;
+    Clock::time_point deadline;
+    Clock::time_point lastFrame;
+    bool started;
+
+    double sleepSlackUs;                      // Koliko sleep_for kasni (opada polako)
+
+    std::vector<long long> histogram;
+    long long frames;
+    long long missedDeadlines;                // Frejm je zavrsen posle roka
+    double sumUs;
+    double maxUs;
+
+public:
+    explicit FramePacer(double targetFps);
+    ~FramePacer();
+
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    // Ceka rok sledeceg frejma (poziva se jednom po frejmu, posle swap-a)
+    void wait();
+
+    // Posle namerne pauze (cekanje na dogadjaj): rokovi krecu od sledeceg wait(), pauza se ne
+    // racuna kao propusten rok niti ulazi u histogram
+    void resume() { started = false; }
+
+    // Raspodela razmaka izmedju frejmova: prosek, percentili, najduzi, propusteni rokovi
+    void printReport() const;
+};
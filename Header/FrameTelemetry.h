@@ -0,0 +1,58 @@
+#pragma once
+#include <chrono>
+#include <mutex>
+#include <string>
+#include "HdrHistogram.h"
+
+// Stalno ukljucena telemetrija frejma: trajanje frejma, update() i render() (CPU strana), posebno
+// za svako stanje igre. Upis je jedan inkrement u histogram, pa moze da radi i na kiosku.
+// update() se meri na niti simulacije, ostalo na niti rendera - histogrami su pod mutex-om, a
+// fajl i konzola rade nad kopijom, pa simulacija ne ceka na I/O.
+// Na svakih intervalSeconds prozor se dopisuje u CSV (ako je zadat fajl) i pocinje nov;
+// F9 ispisuje tekuci prozor i ukupno od pokretanja u konzolu.
+class FrameTelemetry {
+public:
+    enum Metric {
+        METRIC_FRAME,
+        METRIC_UPDATE,
+        METRIC_RENDER,
+        METRIC_INPUT,                         // Od GLFW callback-a do obrade u simulaciji
+        METRIC_COUNT
+    };
+
+    static const int STATE_COUNT = 2;         // GameState: PLAYING, GAME_OVER
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    HdrHistogram window[STATE_COUNT][METRIC_COUNT];
+    HdrHistogram total[STATE_COUNT][METRIC_COUNT];
+    HdrHistogram copy[STATE_COUNT][METRIC_COUNT];     // Za upis/ispis van mutex-a (samo nit rendera)
+    std::mutex mutex;
+    std::string outputPath;                   // Prazno = bez fajla
+    Clock::duration interval;
+    Clock::time_point windowStart;
+
+    bool writeRows(const char* scope, HdrHistogram (&histograms)[STATE_COUNT][METRIC_COUNT]) const;
+    void printTable(const char* title, HdrHistogram (&histograms)[STATE_COUNT][METRIC_COUNT]) const;
+    void copyLocked(HdrHistogram (&histograms)[STATE_COUNT][METRIC_COUNT]);
+
+public:
+    FrameTelemetry(const std::string& outputPath, int intervalSeconds);
+
+    FrameTelemetry(const FrameTelemetry&) = delete;
+    FrameTelemetry& operator=(const FrameTelemetry&) = delete;
+
+    void record(int state, Metric metric, long long microseconds) {
+        std::lock_guard<std::mutex> lock(mutex);
+        window[state][metric].record(microseconds);
+        total[state][metric].record(microseconds);
+    }
+
+    // Jednom po frejmu: kada istekne interval, prozor ide u fajl i pocinje nov
+    void tick();
+    // F9
+    void printReport();
+    // Na izlazu: poslednji prozor i ukupno u fajl
+    void finish();
+};
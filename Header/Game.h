@@ -1,15 +1,99 @@
 ﻿#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include "Block.h"
 #include "TextRenderer.h" 
+#include "Options.h"
+#include "TextureManager.h"
+#include "Leaderboard.h"
+#include "ScorePersistence.h"
+#include "LeaderboardClient.h"
+#include "SpscQueue.h"
+#include "InputLog.h"
+#include "LatencyProbe.h"
+#include "TowerStability.h"
+#include "TowerSway.h"
+#include "Physics2D.h"
+#include "ParticleSystem.h"
+#include "TripleBuffer.h"
+
+class FrameTelemetry;
 
 enum GameState {
     PLAYING,
     GAME_OVER
 };
 
+// Sve sto se pomera izmedju dva koraka simulacije - render ih interpolira
+struct MotionState {
+    float cameraY;
+    float swingAngle;
+    float blockX, blockY;             // Pozicija currentBlock
+    float blockAngle;                 // Rotacija currentBlock (prevrtanje posle kraja igre)
+};
+
+// Odlomljen deo bloka; render crta izmedju prethodne i tekuce poze
+struct DebrisView {
+    Block block;                      // Pozicija posle koraka
+    float angle;
+    float previousX, previousY, previousAngle;
+};
+
+// Udar (blok na toranj, krhotina o zemlju) - render od njega pravi oblak prasine
+struct ImpactEvent {
+    float x, y, width;
+    float strength;                   // Brzina pri udaru
+};
+
+// Stanje igre posle jednog koraka simulacije; render crta samo iz njega
+struct GameSnapshot {
+    static const int IMPACT_HISTORY = 16;
+
+    GameState state;
+    int score;
+    MotionState motion;               // Posle ovog koraka
+    MotionState previousMotion;       // Posle prethodnog koraka
+    double stepTime;                  // glfwGetTime() kada je korak objavljen
+    bool blockFalling;
+    bool hasCurrentBlock;
+    Block currentBlock;
+    // Slot zadrzava svoju kopiju zgrade: u istoj generaciji dopisuju se samo novi spratovi
+    std::vector<Block> tower;
+    unsigned long long towerGeneration;   // Raste sa restartom; u istoj generaciji spratovi se samo dodaju
+    // Njihanje posle koraka za spratove od swayFirstFloor do vrha (samo oni mogu biti na ekranu);
+    // render ga vraca unazad za deo koraka koji jos nije prikazan
+    size_t swayFirstFloor;
+    std::vector<float> swayOffsets;
+    std::vector<float> swayVelocities;
+    bool enteringName;
+    std::string playerName;
+    int backgroundIndex;
+    TopScores topScores;              // Lokalna lista (Leaderboard menja samo nit simulacije)
+    unsigned long long inputSequence; // Raste sa svakim korakom koji je obradio ulaz
+    InputTiming inputTiming;          // Za poslednji takav korak (LatencyProbe)
+    std::vector<DebrisView> debris;
+    // Poslednji udari: udar n je u impacts[n % IMPACT_HISTORY], impactSequence = broj svih udara
+    ImpactEvent impacts[IMPACT_HISTORY];
+    unsigned long long impactSequence;
+
+    GameSnapshot()
+        : state(PLAYING), score(0), stepTime(0.0), blockFalling(false), hasCurrentBlock(false),
+        currentBlock(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f), towerGeneration(0), swayFirstFloor(0),
+        enteringName(false), backgroundIndex(0), inputSequence(0), impactSequence(0)
+    {
+        inputTiming.inputTime = inputTiming.consumedTime = inputTiming.publishedTime = 0.0;
+        MotionState zero = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+        motion = previousMotion = zero;
+        topScores.count = 0;
+    }
+};
+
 class Game {
 private:
     unsigned int VAO, VBO;
@@ -30,6 +114,28 @@ private:
     
     GameState state;
     std::vector<Block> placedBlocks;  // Postavljeni blokovi (zgrada)
+    TowerStability stability;         // Teziste delova zgrade iznad svakog sprata
+    TowerSway sway;                   // Njihanje svakog sprata (lanac opruga)
+    unsigned long long towerGeneration = 0;
+    // Blok koji pada je kruto telo; postavljeni blokovi i zemlja su staticka tela. Blok koji nije
+    // postavljen (kraj igre) ostaje dinamicki - prevrne se preko ivice i padne dok ne legne.
+    PhysicsWorld physics;
+    int groundBody;
+    int fallingBody;                  // -1 = blok visi na uzetu
+    std::vector<int> towerBodies;     // Po jedno staticko telo za svaki sprat
+    float blockAngle;
+    float fallingSpeed;               // Brzina bloka pre poslednjeg koraka (jacina udara)
+    bool fallingTouching;             // Blok posle kraja igre je vec udario u nesto
+    // Deo bloka van oslonca se odlama i pada kao kruto telo
+    struct DebrisPiece {
+        int body;
+        bool touching;
+        float speed;
+        DebrisView view;
+    };
+    std::vector<DebrisPiece> debris;
+    ImpactEvent impacts[GameSnapshot::IMPACT_HISTORY];
+    unsigned long long impactSequence = 0;
     Block* currentBlock;              // Trenutni blok koji se ljulja
     
     bool blockFalling;                // Da li blok pada
@@ -38,11 +144,6 @@ private:
     float swingRadius;                // Radijus ljuljanja
     float fallSpeed;                  // Brzina padanja
     
-    // Parametri zgrade
-    float buildingSwayAngle;          // Ugao njihanja zgrade
-    float buildingSwaySpeed;          // Brzina njihanja zgrade
-    float buildingSwayAmplitude;      // Amplituda njihanja
-    
     // Kamera - prati rast zgrade
     float cameraY;                    // Trenutna Y pozicija kamere (world space)
     float targetCameraY;              // Željena Y pozicija kamere (smooth interpolacija)
@@ -55,10 +156,73 @@ private:
     unsigned int groundTexture;       // Tekstura zemlje
     unsigned int ropeTexture;         // Tekstura konopca
     unsigned int blockTexture;        // Tekstura blokova
-    unsigned int backgroundTexture;   // Tekstura pozadine
+    unsigned int backgroundTexture;   // Tekstura pozadine (trenutna, iz TextureManager-a)
+    float textureQuality;             // Mnozilac velicine teksture u odnosu na velicinu na ekranu
+
+    // Opcione teksture - ucitavaju se lenjo / u pozadini
+    TextureManager* textureManager;
+    size_t textureBudgetBytes;
+    static const int BACKGROUND_COUNT = 4;
+    int backgroundHandles[BACKGROUND_COUNT];
+    int backgroundIndex;              // Pozadine se smenjuju pri svakom restartu
+    int treeHandle, benchHandle, castleHandle;
 
     // Score
     int score;
+    Leaderboard leaderboard;          // Rezultati igraca (PlayersScore.bin), ucitani jednom
+    ScorePersistence scorePersistence;// Upis novih rezultata na I/O niti
+    // Statistika partije za istoriju (RunHistory.bin)
+    double runStartTime;
+    double runEndTime;
+    int runDrops;
+    float runOverhangSum;             // Zbir prepustanja postavljenih blokova (deo sirine bloka)
+    int runOverhangCount;
+    bool runRecorded;                 // Partija je vec poslata u istoriju
+    LeaderboardClient* leaderboardClient;  // nullptr = bez servera rang liste (--leaderboard-port)
+    TopScores remoteTopScores;        // Poslednja top lista sa servera
+    uint64_t remoteTopVersion;        // 0 = server jos nije odgovorio - prikazuje se lokalna lista
+
+    // Simulacija na svojoj niti sa stalnim korakom; sve iznad (osim tekstura i GL-a) menja samo ona.
+    // Posle svakog koraka objavljuje GameSnapshot, a render uzima najnoviji bez zakljucavanja.
+    TripleBuffer<GameSnapshot> snapshots;
+    SpscQueue<InputEvent, 256> inputQueue;
+    std::thread simulationThread;
+    std::atomic<bool> simulationRunning;
+    std::mutex inputWakeMutex;
+    std::condition_variable inputWake;    // Budi simulaciju koja miruje na ekranu kraja igre
+    FrameTelemetry* simulationTelemetry;  // Trajanje update() po koraku (nullptr = bez)
+    MotionState stepStartMotion;      // Pre tekuceg koraka (za interpolaciju)
+    bool blockSpawned;                // Nov blok u ovom koraku - ne interpolira se od starog
+    bool motionReset;                 // Restart u ovom koraku - ne interpolira se nista
+    long long simulationStep;         // Redni broj koraka (vreme za zapis ulaza)
+    double lastStepTime;              // glfwGetTime() poslednjeg objavljenog koraka
+    GameState publishedState;         // Stanje u poslednjem objavljenom snapshot-u
+    InputLog inputLog;                // --record-input / --replay-input
+    bool replayingInput;              // Pustanje zapisa - rezultati i partije se ne cuvaju ponovo
+    // Boje blokova: sopstveni xorshift32 sa semenom iz zapisa ulaza. rand() ne moze - MSVC CRT ga
+    // drzi po niti, a srand() u konstruktoru ne bi stigao do niti simulacije.
+    unsigned int randomState = 0x9E3779B9u;
+    unsigned long long inputSequence; // Koraci koji su obradili ulaz sa tastature/misa
+    InputTiming inputTiming;          // Prvi dogadjaj poslednjeg takvog koraka
+    bool stepHadInput;
+    // Samo nit rendera
+    int pinnedBackground;             // Pozadina koja je trenutno zakacena u TextureManager-u
+    float renderCameraY;              // Kamera iz snapshot-a koji se crta
+    unsigned long long shownInputSequence;
+    bool newInputShown;               // Ovaj frejm prvi crta rezultat nekog ulaza
+    bool texturesPending;             // Poslednji frejm je crtan sa nekom teksturom koja se jos ucitava
+    ParticleSystem dust{ DUST_CAPACITY };  // Cisto vizuelno - zivi samo na niti rendera
+    unsigned int particleVAO = 0, particleVBO = 0;
+    unsigned long long emittedImpacts = 0;
+    double lastDustTime = 0.0;
+    // Spratovi kao instance: geometrija/boja se salju kada se zgrada promeni, pomeraji svaki frejm
+    unsigned int towerVAO = 0, towerInstanceVBO = 0, towerOffsetVBO = 0;
+    size_t towerCapacity = 0;         // Instanci u GPU baferima
+    size_t uploadedFloors = 0;
+    size_t uploadedSwayFirst = 0;     // Pomeraji ispod ovog sprata su na GPU-u nule
+    unsigned long long uploadedGeneration = 0;
+    std::vector<float> towerInstanceData;
+    std::vector<float> towerOffsets;
     
     // Konstante - bazne vrednosti (za kvadratni ekran 1:1)
     const float BLOCK_WIDTH = 0.25f;   // Bazna širina bloka
@@ -70,37 +234,100 @@ private:
     const float GROUND_Y = -0.95f;     // Pozicija zemlje (world space)
     const float OVERHANG_LIMIT = 0.33f; // 1/3 bloka sme da viri
     const float ROPE_LENGTH = 0.75f;    // Dužina užeta (radijus kružne putanje)
+    const float ROPE_WIDTH = 0.03f;     // Debljina užeta
     const float MAX_SWING_ANGLE = 1.0f; // Maksimalni ugao ljuljanja u radijanima (~57 stepeni)
     const float GRAVITY = 9.81f;       // Gravitaciona konstanta
     const float CAMERA_SPEED = 3.0f;   // Brzina praćenja kamere (smooth interpolacija)
+    const double SIMULATION_RATE = 120.0;  // Koraka simulacije u sekundi
+    const float MAX_DROP_SHIFT = 0.05f;    // Najvise toliko (s) se klatno vraca/pomera na trenutak klika
+    const float DROP_SUB_STEP = 0.001f;    // Korak integracije pri tom pomeranju
+    const double CURSOR_BLINK_INTERVAL = 0.5;
+    const int IDLE_WAKE_MS = 250;          // Simulacija koja miruje ipak proverava stanje bar ovoliko cesto
+    static const int DUST_CAPACITY = 131072;
+    static const int SWAY_VISIBLE_FLOORS = 64;     // Kamera prati vrh: visina ekrana je najvise ~16 spratova i u portretu
+    static const int TOWER_INSTANCE_FLOATS = 8;    // x, y, sirina, visina, r, g, b, a
+    const float DUST_PER_SPEED = 80.0f;    // Cestica po jedinici brzine udara
+    const int MAX_DEBRIS = 24;             // Najstarija krhotina nestaje kada ih ima vise
+    const float MIN_DEBRIS_WIDTH = 0.005f; // Uzi visak ostaje na bloku
+    const float DEBRIS_KICK = 0.15f;       // Pocetna brzina krhotine od zgrade (jedinica/s)
+    const float MIN_IMPACT_SPEED = 0.3f;   // Sporiji dodir ne dize prasinu
+    const float SWAY_KICK = 2.0f;          // Brzina vrha po delu sirine za koji blok promasi centar
+
+    // Dekoracije na zemlji (world space)
+    const float TREE_WIDTH = 0.36f;
+    const float TREE_HEIGHT = 0.5f;
+    const float BENCH_WIDTH = 0.3f;
+    const float BENCH_HEIGHT = 0.18f;
+    const float CASTLE_WIDTH = 0.6f;
+    const float CASTLE_HEIGHT = 0.4f;
     
     void initOpenGL();
     void initTextRenderer();
-    void preprocessTexture(unsigned int& texture, const char* filepath);
+    void preprocessTexture(unsigned int& texture, const char* filepath, float screenWidth, float screenHeight);
     void spawnNewBlock();
     void updateCamera(float deltaTime);
     void drawBlock(const Block& block, float offsetX = 0.0f, float rotation = 0.0f);
     void drawRope(float x1, float y1, float x2, float y2);
     void drawHook(float x, float y);
+    void drawDecoration(unsigned int texture, float x, float width, float height);
+    void initTextureManager();
     void drawText(const char* text, float x, float y, float scale);
+    void endRun();
+    void recordRun(const std::string& name);
     float getRandomColor();
+
+    void simulationLoop();
+    void applyInput(const InputEvent& event);
+    MotionState captureMotion() const;
+    void publishSnapshot();
+    void update(float deltaTime);
+    void advanceSwing(float deltaTime);
+    void resetPhysics();
+    void stepPhysics(float deltaTime);
+    void freezeFallingBlock();
+    bool sweepFallingBlock(int target, float deltaTime);
+    void supportedSpan(const Block& base, float& left, float& right) const;
+    void breakOffOverhang(const Block& base);
+    void spawnDebris(float left, float right, float direction);
+    void addImpact(float x, float y, float width, float strength);
+    void drawDust();
+    void drawTower(const GameSnapshot& view, float alpha);
+    void dropBlock(int stepOffsetUs);
+    void restart();
+	void onKeyPressed(int key);
+	void onCharEntered(unsigned int codepoint);
     
 public:
-    Game();
+    Game(int width, int height, const Options& options);
     ~Game();
-    
+
+    // Pre izlaza: zaustavlja simulaciju i saceka da se svi rezultati upisu na disk
+    void shutdown();
+
+    // Pokrece nit simulacije; telemetry (moze nullptr) dobija trajanje svakog koraka
+    void startSimulation(FrameTelemetry* telemetry);
+    // Ceka da se tekuci korak zavrsi; ulaz koji je ostao u redu se odbacuje
+    void stopSimulation();
+
+    // Iz GLFW callback-ova (dobija vreme glfwGetTime()); false ako je red pun (dogadjaj se odbacuje).
+    // Simulacija prazni red na pocetku svakog koraka.
+    bool postInput(InputEvent::Type type, int key = 0, unsigned int codepoint = 0);
+
+    // Stanje iz snapshot-a koji se poslednji crtao (samo nit rendera)
     GameState getGameState() const;
     void setAspectRatio(float width, float height);
     void setWindowSize(int width, int height);
-	void onKeyPressed(int key);
-	void onCharInput(unsigned int codepoint);
-	void onCharEntered(unsigned int codepoint);
     
-    void update(float deltaTime);
     void render();
-    void dropBlock();
-    void restart();
+    // Ekran kraja igre: scena stoji, pa Main crta samo kada needsRedraw() (novo stanje, treptaj
+    // kursora, ucitana tekstura, nova rang lista), a izmedju ceka dogadjaj najvise getIdleTimeout() s
+    bool isIdle() const { return getGameState() == GAME_OVER; }
+    bool needsRedraw();
+    double getIdleTimeout() const;
+
+    // Posle render(): da li je frejm prvi koji prikazuje obradjen ulaz (jednom po ulazu)
+    bool takeShownInput(InputTiming& timing);
     
-    bool isGameOver() const { return state == GAME_OVER; }
-    int getScore() const { return score; }
+    bool isGameOver() const { return getGameState() == GAME_OVER; }
+    int getScore() const { return snapshots.front().score; }
 };
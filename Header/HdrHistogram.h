@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Histogram sa logaritamsko-linearnim korpama (kao HdrHistogram): vrednosti do 256 imaju svoju
+// korpu, a svaka sledeca oktava je podeljena na 128 korpi - relativna greska je ispod 1% za
+// bilo koju vrednost, uz nekoliko KB memorije. Upis je O(1), bez alokacija.
+class HdrHistogram {
+private:
+    static const int SUB_BUCKET_BITS = 7;
+    static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+
+    std::vector<uint32_t> counts;
+    long long highestTrackable;
+    long long total;
+    long long maxValue;
+
+    static int bucketIndex(long long value);
+    static long long bucketHighValue(int index);
+
+public:
+    // Vrednosti iznad highestTrackable se upisuju kao highestTrackable
+    explicit HdrHistogram(long long highestTrackable = 60000000);
+
+    void record(long long value);
+    void add(const HdrHistogram& other);
+    void reset();
+
+    long long getCount() const { return total; }
+    long long getMax() const { return maxValue; }
+    // Najmanja vrednost ispod koje je fraction upisanih vrednosti (gornja granica korpe)
+    long long percentile(double fraction) const;
+};
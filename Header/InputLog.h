@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Ulaz iz GLFW callback-ova; ide kroz red do niti simulacije
+struct InputEvent {
+    enum Type {
+        DROP,
+        RESTART,
+        KEY,
+        CHAR
+    };
+
+    Type type;
+    int key;
+    unsigned int codepoint;
+    double timestamp;                 // glfwGetTime() u callback-u
+    int stepOffsetUs;                 // timestamp - vreme poslednjeg koraka (popunjava simulacija)
+};
+
+// Ulaz zapisan po koracima simulacije. Simulacija ima stalan korak, pa isto seme za boje blokova i isti
+// dogadjaji u istim koracima daju istu partiju - zapis se moze pustiti ponovo (--replay-input).
+// Format je tekstualni CSV:
+//     seed,<seme>
+//     step,type,key,codepoint,offsetUs
+//     120,DROP,0,0,4210
+// offsetUs je stepOffsetUs - pustanje pusta blok iz iste tacke zamaha kao uzivo.
+class InputLog {
+public:
+    struct Entry {
+        long long step;
+        InputEvent event;
+    };
+
+private:
+    FILE* file;                       // Snimanje (nullptr = ne snima se)
+    std::vector<Entry> entries;       // Pustanje
+    size_t nextEntry;
+
+public:
+    InputLog() : file(nullptr), nextEntry(0) {}
+    ~InputLog();
+
+    InputLog(const InputLog&) = delete;
+    InputLog& operator=(const InputLog&) = delete;
+
+    // Snimanje: pravi fajl i upisuje seme
+    bool openRecord(const std::string& path, unsigned int seed);
+    void record(long long step, const InputEvent& event);
+
+    // Pustanje: ucitava ceo zapis
+    bool load(const std::string& path, unsigned int& seed);
+    // Sledeci dogadjaj zapisan za korak step (ili raniji); false kada ih za taj korak vise nema
+    bool nextDue(long long step, InputEvent& event);
+    bool isReplaying() const { return nextEntry < entries.size(); }
+
+    void close();
+};
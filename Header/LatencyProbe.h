@@ -0,0 +1,51 @@
+#pragma once
+#include "HdrHistogram.h"
+
+// Vremena (glfwGetTime) kroz koja je prosao dogadjaj ulaza do koraka simulacije koji ga je obradio
+struct InputTiming {
+    double inputTime;                 // GLFW callback
+    double consumedTime;              // Simulacija ga je uzela iz reda
+    double publishedTime;             // Snapshot sa rezultatom je objavljen
+};
+
+// Latencija od ulaza do slike: za svaki dogadjaj koji se prvi put vidi na ekranu meri se red
+// ulaza, korak simulacije, cekanje na render, render, swap i (opciono) GPU. glFinish() posle
+// swap-a meri kada je GPU zaista zavrsio, ali i sam usporava frejm - zato je opcion.
+// Sluzi za podesavanje FramePacer-a i --swap-interval na ekranima osetljivim na dodir.
+class LatencyProbe {
+public:
+    enum Stage {
+        STAGE_QUEUE,                  // Callback -> simulacija
+        STAGE_SIMULATION,             // Obrada -> objavljen snapshot
+        STAGE_WAIT_RENDER,            // Snapshot -> pocetak rendera koji ga crta
+        STAGE_RENDER,
+        STAGE_SWAP,                   // Kraj rendera -> povratak iz glfwSwapBuffers
+        STAGE_GPU,                    // Swap -> glFinish (samo sa gpu)
+        STAGE_TOTAL,                  // Callback -> swap (ili GPU)
+        STAGE_COUNT
+    };
+
+private:
+    HdrHistogram histograms[STAGE_COUNT];
+    bool measureGpu;
+    bool pending;                     // Frejm koji prvi prikazuje dogadjaj je u toku
+    InputTiming timing;
+    double renderStart;
+    double renderEnd;
+    double swapEnd;
+
+    static long long toMicroseconds(double seconds);
+    void finishSample(double endTime);
+
+public:
+    explicit LatencyProbe(bool measureGpu);
+
+    // Frejm je nacrtao snapshot sa novim ulazom
+    void frameRendered(const InputTiming& timing, double renderStart, double renderEnd);
+    // Posle glfwSwapBuffers; true ako treba glFinish() pa gpuFinished()
+    bool swapReturned(double time);
+    void gpuFinished(double time);
+
+    // Percentili po fazama (ms)
+    void printReport() const;
+};
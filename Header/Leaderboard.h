@@ -0,0 +1,43 @@
+#pragma once
+#include <string>
+#include "ScoreIndex.h"
+#include "ScoreStore.h"
+
+// Gotove linije za prikaz najboljih rezultata - render() ih samo crta, bez alokacija
+struct TopScores {
+    static const int MAX_ENTRIES = 3;
+    static const int LINE_LENGTH = 48;
+
+    int count;
+    char lines[MAX_ENTRIES][LINE_LENGTH];   // "ime skor", [0] = najbolji
+
+    void setLine(int index, const char* name, int score);
+};
+
+// Rezultati igraca u memoriji. Snapshot (ScoreStore) se cita jednom pri pokretanju, a top lista se
+// preracunava samo kada se rezultat promeni. Upis na disk radi ScoreJournal.
+class Leaderboard {
+private:
+    ScoreIndex index;
+    TopScores topScores;
+
+    void rebuildTopScores();
+
+public:
+    Leaderboard();
+
+    void load(const ScoreStore& store);
+
+    // Isto pravilo kao ranije u onKeyPressed: poslednji rezultat igraca zamenjuje prethodni
+    void submit(const std::string& name, int score);
+
+    const TopScores& getTopScores() const { return topScores; }
+
+    // Prvih k igraca; visitor(name, score)
+    template <typename Visitor>
+    void forEachTop(size_t k, Visitor visitor) const { index.forEachTop(k, visitor); }
+
+    long long rank(const std::string& name) const { return index.rank(name); }
+    double percentile(const std::string& name) const { return index.percentile(name); }
+    size_t size() const { return index.size(); }
+};
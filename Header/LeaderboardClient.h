@@ -0,0 +1,63 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Leaderboard.h"
+#include "LeaderboardProtocol.h"
+#include "Net.h"
+#include "ScoreStore.h"
+#include "SpscQueue.h"
+
+// Klijent centralne rang liste (Kostur.exe --leaderboard-port[=port]).
+// Sve mrezno radi pozadinska nit: rezultati se skupljaju u grupe i salju dok server ne potvrdi
+// (ponovni pokusaji sa sve duzim razmakom), a top lista se osvezava periodicno uz verziju, pa
+// server salje podatke samo kada su se promenili. Igra nikad ne ceka mrezu.
+class LeaderboardClient {
+private:
+    static const size_t QUEUE_CAPACITY = 256;
+
+    int port;
+    SpscQueue<ScoreRecord, QUEUE_CAPACITY> outgoing;
+    std::deque<ScoreRecord> pending;  // Samo radna nit: poslato, ali jos nepotvrdjeno
+
+    std::thread worker;
+    std::atomic<bool> stopping;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+
+    SocketHandle connection;
+    std::chrono::milliseconds retryDelay;
+    bool topChanged;                  // ACK je javio noviju verziju top liste
+
+    std::mutex topMutex;              // Stiti top i topVersion
+    TopScores top;
+    uint64_t topVersion;              // 0 = jos nista nije stiglo
+
+    void workerLoop();
+    bool ensureConnected();
+    void disconnect();
+    bool sendPending();
+    bool refreshTop();
+
+public:
+    explicit LeaderboardClient(int port);
+    ~LeaderboardClient();
+
+    LeaderboardClient(const LeaderboardClient&) = delete;
+    LeaderboardClient& operator=(const LeaderboardClient&) = delete;
+
+    void start();
+    // Pokusava da posalje ono sto je ostalo (bez novog povezivanja), pa zaustavlja nit
+    void stop();
+
+    // Poziva samo nit igre; ne blokira
+    bool submit(const std::string& name, int score);
+
+    // Ne blokira (try_lock): kopira top listu ako je novija od version; true ako je kopirano
+    bool pollTopScores(TopScores& out, uint64_t& version);
+};
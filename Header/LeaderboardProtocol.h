@@ -0,0 +1,105 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Net.h"
+
+// Binarni protokol rang liste (little-endian):
+//     okvir:  uint32 duzina | uint8 tip | telo
+//     SUBMIT_BATCH      uint16 broj | broj x (uint8 duzinaImena, ime, int32 skor, int64 vremeMs)
+//     SUBMIT_ACK        uint32 prihvaceno | uint64 verzija
+//     GET_TOP           uint64 poznataVerzija
+//     TOP               uint64 verzija | uint8 broj | broj x (uint8 duzinaImena, ime, int32 skor)
+//     TOP_NOT_MODIFIED  uint64 verzija (klijent vec ima ovu verziju)
+// Verzija se menja samo kada se promeni top lista, pa je odgovor najcesce TOP_NOT_MODIFIED.
+enum MessageType {
+    MSG_SUBMIT_BATCH = 1,
+    MSG_SUBMIT_ACK = 2,
+    MSG_GET_TOP = 3,
+    MSG_TOP = 4,
+    MSG_TOP_NOT_MODIFIED = 5
+};
+
+static const int LEADERBOARD_DEFAULT_PORT = 7420;
+static const uint32_t MAX_FRAME_LENGTH = 64 * 1024;
+static const int MAX_SUBMIT_BATCH = 1024;
+
+class ByteWriter {
+private:
+    std::vector<unsigned char>& out;
+
+    void raw(uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+        }
+    }
+
+public:
+    explicit ByteWriter(std::vector<unsigned char>& buffer) : out(buffer) {}
+
+    void u8(uint8_t value) { out.push_back(value); }
+    void u16(uint16_t value) { raw(value, 2); }
+    void u32(uint32_t value) { raw(value, 4); }
+    void u64(uint64_t value) { raw(value, 8); }
+    void i32(int32_t value) { raw(static_cast<uint32_t>(value), 4); }
+    void i64(int64_t value) { raw(static_cast<uint64_t>(value), 8); }
+    void name(const char* text, size_t length) {
+        u8(static_cast<uint8_t>(length));
+        out.insert(out.end(), text, text + length);
+    }
+};
+
+// Citanje van granica ne baca izuzetak - postavlja ok = false i vraca nule
+class ByteReader {
+private:
+    const unsigned char* data;
+    size_t remaining;
+    bool valid;
+
+    uint64_t raw(int bytes) {
+        if (remaining < static_cast<size_t>(bytes)) {
+            valid = false;
+            remaining = 0;
+            return 0;
+        }
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; i++) {
+            value |= static_cast<uint64_t>(data[i]) << (8 * i);
+        }
+        data += bytes;
+        remaining -= bytes;
+        return value;
+    }
+
+public:
+    explicit ByteReader(const std::vector<unsigned char>& buffer)
+        : data(buffer.data()), remaining(buffer.size()), valid(true) {}
+
+    uint8_t u8() { return static_cast<uint8_t>(raw(1)); }
+    uint16_t u16() { return static_cast<uint16_t>(raw(2)); }
+    uint32_t u32() { return static_cast<uint32_t>(raw(4)); }
+    uint64_t u64() { return raw(8); }
+    int32_t i32() { return static_cast<int32_t>(static_cast<uint32_t>(raw(4))); }
+    int64_t i64() { return static_cast<int64_t>(raw(8)); }
+
+    // Ime u bafer od maxLength + 1 znakova (sa '\0'); predugacko ime je greska
+    bool name(char* text, size_t maxLength) {
+        size_t length = u8();
+        if (!valid || length > maxLength || remaining < length) {
+            valid = false;
+            return false;
+        }
+        for (size_t i = 0; i < length; i++) {
+            text[i] = static_cast<char>(data[i]);
+        }
+        text[length] = '\0';
+        data += length;
+        remaining -= length;
+        return true;
+    }
+
+    bool ok() const { return valid; }
+};
+
+bool sendFrame(SocketHandle socket, uint8_t type, const std::vector<unsigned char>& payload);
+bool receiveFrame(SocketHandle socket, uint8_t& type, std::vector<unsigned char>& payload);
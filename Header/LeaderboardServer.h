@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Leaderboard.h"
+#include "LeaderboardProtocol.h"
+#include "Net.h"
+#include "Options.h"
+#include "ScorePersistence.h"
+
+// Centralna rang lista za vise kioska (Kostur.exe --leaderboard-daemon[=port]).
+// Slusa samo na loopback TCP-u; svaki klijent ima svoju nit, a rang lista i upis na disk
+// su zajednicki (jedan mutex). Rezultati se cuvaju kroz isti dnevnik/skladiste kao u igri.
+class LeaderboardServer {
+private:
+    Leaderboard leaderboard;
+    ScorePersistence* persistence;    // nullptr = samo u memoriji
+    std::mutex mutex;                 // leaderboard, topVersion
+    std::mutex submitMutex;           // Jedini proizvodjac za red persistence; uzima se pre mutex-a
+    uint64_t topVersion;
+
+    SocketHandle listener;
+    int port;
+    std::atomic<bool> stopping;
+    std::thread acceptThread;
+    std::mutex clientsMutex;
+    std::vector<SocketHandle> clients;
+
+    struct ClientThread {
+        std::thread thread;
+        std::atomic<bool> done;
+        ClientThread() : done(false) {}
+    };
+    std::list<ClientThread> clientThreads;    // Samo acceptLoop() (i stop() posle njega); zavrsene se spajaju
+
+    void acceptLoop();
+    void reapClientThreads();
+    void serveClient(SocketHandle client, std::atomic<bool>* done);
+    bool handleSubmit(ByteReader& reader, std::vector<unsigned char>& response);
+    uint8_t handleGetTop(ByteReader& reader, std::vector<unsigned char>& response);
+
+public:
+    // storePath prazan = bez upisa na disk (npr. za benchmark)
+    LeaderboardServer(const std::string& storePath, FsyncPolicy fsyncPolicy, int fsyncIntervalMs);
+    ~LeaderboardServer();
+
+    LeaderboardServer(const LeaderboardServer&) = delete;
+    LeaderboardServer& operator=(const LeaderboardServer&) = delete;
+
+    // port 0 = bilo koji slobodan port (vidi getPort)
+    bool start(int port);
+    void stop();
+
+    int getPort() const { return port; }
+};
+
+// Daemon bez prozora; radi do Ctrl+C
+int runLeaderboardDaemon(const Options& options);
@@ -0,0 +1,87 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "SpscQueue.h"
+
+enum LogLevel {
+    LOG_LEVEL_DEBUG,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARN,
+    LOG_LEVEL_ERROR
+};
+
+// Asinhroni log za vreme igre. Poruka se formatira (snprintf) u red niti koja pise - svaka nit
+// ima svoj SpscQueue, pa upis nema ni zakljucavanja ni sistemskog poziva. Pozadinska nit na
+// svakih FLUSH_INTERVAL_MS prazni sve redove, slaze poruke po vremenu i pise ih u konzolu u
+// jednoj grupi (jedan fflush). Ako je red pun, poruka se odbacuje i broji.
+// Dok logger nije pokrenut (alati, pokretanje) i posle stop(), poruke idu direktno u konzolu.
+class Logger {
+public:
+    static const size_t MESSAGE_LENGTH = 200;
+    static const size_t QUEUE_CAPACITY = 512;
+    static const int FLUSH_INTERVAL_MS = 20;
+
+    struct Record {
+        LogLevel level;
+        int thread;                   // Redni broj niti (po prvoj poruci)
+        double timeMs;                // Od pokretanja logger-a
+        char message[MESSAGE_LENGTH];
+    };
+
+private:
+    struct ThreadQueue {
+        SpscQueue<Record, QUEUE_CAPACITY> queue;
+        std::atomic<long long> dropped;
+        int index;
+    };
+
+    std::mutex registryMutex;
+    std::vector<ThreadQueue*> queues;  // Niti su malobrojne - redovi zive do kraja programa
+    std::thread flusher;
+    std::atomic<bool> running;
+    std::atomic<int> minLevel;
+    std::chrono::steady_clock::time_point origin;
+    std::mutex wakeMutex;
+    std::condition_variable wake;     // Samo za stop() - pisci nikad ne bude flusher
+    std::vector<Record> batch;        // Samo flusher
+
+    Logger();
+    ThreadQueue* threadQueue();
+    void flushLoop();
+    void drain();
+    static void writeRecord(const Record& record);
+
+public:
+    static Logger& instance();
+
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    void start(LogLevel level);
+    // Ispisuje sve sto je ostalo u redovima; dalje poruke idu direktno
+    void stop();
+
+    bool isEnabled(LogLevel level) const { return level >= minLevel.load(std::memory_order_relaxed); }
+
+#if defined(__GNUC__)
+    void write(LogLevel level, const char* format, ...) __attribute__((format(printf, 3, 4)));
+#else
+    void write(LogLevel level, const char* format, ...);
+#endif
+};
+
+// printf format; LOG_DEBUG se u release build-u (NDEBUG) ne prevodi - ni argumenti se ne racunaju
+#ifdef NDEBUG
+#define LOG_DEBUG(...) ((void)0)
+#else
+#define LOG_DEBUG(...) Logger::instance().write(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#endif
+#define LOG_INFO(...) Logger::instance().write(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARN(...) Logger::instance().write(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_ERROR(...) Logger::instance().write(LOG_LEVEL_ERROR, __VA_ARGS__)
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Fajl mapiran u memoriju za citanje i upis (Windows: CreateFileMapping, ostalo: mmap).
+class MappedFile {
+private:
+#ifdef _WIN32
+    void* file;
+    void* mapping;
+#else
+    int fd;
+#endif
+    unsigned char* view;
+    size_t length;
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Otvara ili pravi fajl; ako je minSize veci od fajla, fajl se prosiruje nulama
+    bool open(const std::string& path, size_t minSize);
+    void close();
+
+    // sync = true: ceka da izmene stignu na disk
+    bool flush(bool sync);
+
+    bool isOpen() const { return view != nullptr; }
+    unsigned char* data() const { return view; }
+    size_t size() const { return length; }
+};
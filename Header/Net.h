@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Tanak sloj nad TCP soketima (Winsock / POSIX), samo za loopback (127.0.0.1).
+#ifdef _WIN32
+typedef uintptr_t SocketHandle;
+#else
+typedef int SocketHandle;
+#endif
+
+extern const SocketHandle INVALID_SOCKET_HANDLE;
+
+// Winsock zahteva inicijalizaciju; na POSIX-u iskljucuje SIGPIPE. Poziva se u paru sa netShutdown.
+bool netInit();
+void netShutdown();
+
+// port 0 = bilo koji slobodan port (upisuje se u boundPort)
+SocketHandle netListenLoopback(int port, int* boundPort);
+// INVALID_SOCKET_HANDLE ako nema klijenta za timeoutMs
+SocketHandle netAccept(SocketHandle listener, int timeoutMs);
+SocketHandle netConnectLoopback(int port);
+
+bool netSendAll(SocketHandle socket, const void* data, size_t length);
+bool netReceiveAll(SocketHandle socket, void* data, size_t length);
+
+// Prekida blokirajuce citanje na drugoj niti
+void netShutdownSocket(SocketHandle socket);
+void netClose(SocketHandle socket);
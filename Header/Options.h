@@ -0,0 +1,42 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Logger.h"
+
+// Kada se dnevnik rezultata upisuje na disk (fsync)
+enum FsyncPolicy {
+    FSYNC_NEVER,      // Samo fflush - prezivi pad procesa, ne i sistema
+    FSYNC_BATCH,      // fsync posle svake grupe upisa
+    FSYNC_INTERVAL    // fsync najvise jednom u intervalu
+};
+
+// Opcije komandne linije (npr. Kostur.exe --startup-trace --startup-budget-ms=1500)
+struct Options {
+    std::string startupTracePath;     // Prazno = bez Chrome trace izvoza
+    double startupBudgetMs = 0.0;     // 0 = bez budzeta; inace izlaz sa greskom ako se prekoraci
+    float textureQuality = 1.0f;      // Mnozilac velicine teksture u odnosu na ekran (0 = puna rezolucija)
+    int textureBudgetMb = 48;         // Budzet za opcione teksture (pozadine, dekoracije)
+    FsyncPolicy scoreFsync = FSYNC_BATCH;
+    int scoreFsyncIntervalMs = 1000;  // Za FSYNC_INTERVAL
+    std::vector<std::string> importScores;   // CSV fajlovi za spajanje u skladiste (alat, bez igre)
+    std::string exportScores;         // CSV u koji se izvozi skladiste
+    bool mergeBest = false;           // Pri spajanju vazi bolji, a ne poslednji rezultat
+    std::string scoreStorePath = "PlayersScore.bin";
+    std::string runHistoryPath = "RunHistory.bin";
+    int runReportDays = 0;            // != 0: najbolji rezultati iz istorije partija za N dana (bez igre)
+    std::string telemetryPath;        // CSV telemetrije frejma (prazno = samo F9 u konzoli)
+    int telemetryIntervalSeconds = 60;
+    std::string bench;                // Ime headless benchmark-a (prazno = igra)
+    long long benchCount = 0;         // Velicina benchmark-a (0 = podrazumevana)
+    int leaderboardDaemonPort = 0;    // != 0: radi kao server rang liste (bez igre)
+    int leaderboardPort = 0;          // != 0: igra salje rezultate serveru na ovom portu
+    std::string inputRecordPath;      // Zapis ulaza po koracima simulacije (prazno = bez)
+    std::string inputReplayPath;      // Pustanje zapisa ulaza umesto tastature/misa
+    bool latencyProbe = false;        // Merenje latencije ulaz -> slika
+    bool latencyProbeGpu = false;     // ... i glFinish() posle swap-a (vreme GPU-a)
+    int swapInterval = -1;            // glfwSwapInterval (-1 = podrazumevano od drajvera)
+    LogLevel logLevel = LOG_LEVEL_INFO;
+};
+
+bool parseOptions(int argc, char** argv, Options& options);
+void printUsage();
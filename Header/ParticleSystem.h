@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Prasina od udara: bazen fiksnog kapaciteta sa podacima po poljima (SoA). Integracija ide po
+// 4 cestice odjednom (SSE), a izlaz je niz instanci (x, y, velicina, providnost) spreman za jedan
+// instancirani poziv crtanja. Nema alokacije po cestici; kada je bazen pun, nove se odbacuju.
+class ParticleSystem {
+public:
+    static const int INSTANCE_FLOATS = 4;
+
+private:
+    size_t capacity;
+    size_t count;
+    // Duzine su zaokruzene na 4 - poslednja grupa se racuna cela, bez posebnog repa
+    std::vector<float> positionX, positionY;
+    std::vector<float> velocityX, velocityY;
+    std::vector<float> life;          // Preostalo vreme (s); <= 0 = uklanja se u sledecem update()
+    std::vector<float> size;
+    std::vector<float> instances;     // INSTANCE_FLOATS po cestici
+    unsigned int randomState;         // Sopstveni generator - ne dira boje blokova (zapis ulaza)
+
+    float nextRandom();
+    void removeDead();
+
+public:
+    explicit ParticleSystem(size_t capacity);
+
+    // Oblak duz ivice [x - width/2, x + width/2] na visini y; strength ~ brzina udara (jedinica/s).
+    // Vraca broj dodatih cestica.
+    size_t emitDust(float x, float y, float width, int particles, float strength);
+
+    // Pomera sve cestice za dt i puni niz instanci
+    void update(float dt);
+    void clear() { count = 0; }
+
+    size_t getCount() const { return count; }
+    size_t getCapacity() const { return capacity; }
+    const float* getInstances() const { return instances.data(); }
+};
@@ -0,0 +1,125 @@
+#pragma once
+#include <cmath>
+#include <vector>
+
+struct Vec2 {
+    float x, y;
+
+    Vec2() : x(0.0f), y(0.0f) {}
+    Vec2(float xValue, float yValue) : x(xValue), y(yValue) {}
+
+    Vec2 operator+(const Vec2& other) const { return Vec2(x + other.x, y + other.y); }
+    Vec2 operator-(const Vec2& other) const { return Vec2(x - other.x, y - other.y); }
+    Vec2 operator-() const { return Vec2(-x, -y); }
+    Vec2 operator*(float scale) const { return Vec2(x * scale, y * scale); }
+    Vec2& operator+=(const Vec2& other) { x += other.x; y += other.y; return *this; }
+    Vec2& operator-=(const Vec2& other) { x -= other.x; y -= other.y; return *this; }
+};
+
+// Pravougaono kruto telo (blok). Staticko telo ima invMass = 0 (zemlja, spratovi zgrade) i ne
+// pomera se posle createBody() (sortirano je po visini).
+struct RigidBody {
+    Vec2 position;
+    float angle;
+    Vec2 velocity;
+    float angularVelocity;
+    Vec2 halfSize;
+    float invMass;
+    float invInertia;
+    float friction;
+    float sleepTime;                  // Koliko dugo je telo skoro mirno
+    float consumedTime;               // Deo sledeceg koraka koji je telo vec preslo (advanceToImpact)
+    bool awake;
+    bool active;                      // Slot je u upotrebi (id-jevi su stabilni)
+
+    bool isStatic() const { return invMass == 0.0f; }
+};
+
+// Mali 2D fizicki svet za blokove: SAT kontakti kutija-kutija (do 2 tacke, referentna ivica +
+// odsecanje), sekvencijalni impulsi sa trenjem i toplim startom, fiksni korak simulacije.
+// Tela koja se dodiruju cine ostrvo; kada je celo ostrvo mirno SLEEP_TIME sekundi, uspava se -
+// uspavana i staticka tela se ne integrisu i ne proveravaju medjusobno, pa slegnuti blokovi ne
+// kostaju nista. Dodir budnog tela budi uspavano. Staticka tela su sortirana po y, pa budno telo
+// proverava samo staticka tela u svom pojasu visine, a ne ceo toranj.
+class PhysicsWorld {
+public:
+    static const int MAX_CONTACT_POINTS = 2;
+
+    struct ContactPoint {
+        Vec2 position;
+        float separation;             // < 0 = prodiranje
+        float normalImpulse;          // Akumulirano (topli start u sledecem koraku)
+        float tangentImpulse;
+        float massNormal;
+        float massTangent;
+        float bias;
+    };
+
+    // Kontakti para tela; normala je od A ka B
+    struct Manifold {
+        int bodyA, bodyB;
+        Vec2 normal;
+        int count;
+        ContactPoint points[MAX_CONTACT_POINTS];
+    };
+
+private:
+    std::vector<RigidBody> bodies;
+    std::vector<int> freeBodies;
+    std::vector<Manifold> manifolds;
+    std::vector<Manifold> previousManifolds;  // Za topli start
+    std::vector<int> islandParent;            // Union-find po telima
+    std::vector<float> islandSleep;           // Najkrace mirovanje po korenu ostrva
+    std::vector<int> awakeBodies;
+    std::vector<int> dynamicBodies;           // Aktivna dinamicka tela, budna i uspavana
+    std::vector<int> staticBodies;            // Mala staticka tela, rastuce po y centra
+    std::vector<int> wideStatics;             // Staticka tela veca od WIDE_STATIC_REACH (zemlja)
+    float staticReach;                        // Najveci obuhvat (hx + hy) u staticBodies
+    Vec2 gravity;
+    int iterations;
+    int awakeCount;                           // Budna dinamicka tela
+
+    void collide();
+    void collidePair(int moving, int other, bool otherMoving);
+    void warmStart(Manifold& manifold);
+    void preStep(Manifold& manifold, float inverseDt);
+    void applyImpulse(Manifold& manifold);
+    void updateSleep(float dt);
+    int findIsland(int body);
+
+public:
+    static int collideBoxes(const RigidBody& a, const RigidBody& b, Manifold& manifold);
+
+    // Kutija a se krece po a(t) = a + velocity * t + curve * t^2 (bez rotacije), b miruje: prvo
+    // vreme u [0, duration] kada se preklapaju (SAT po sve 4 ose). Vec preklopljene -> 0. Dodir
+    // samo ivicom se ne racuna.
+    static bool sweepBoxes(const RigidBody& a, const Vec2& velocity, const Vec2& curve, float duration,
+        const RigidBody& b, float& time);
+
+    PhysicsWorld();
+
+    void setGravity(const Vec2& value) { gravity = value; }
+
+    // density = 0 -> staticko telo
+    int createBody(const Vec2& position, const Vec2& halfSize, float density, float angle = 0.0f);
+    void destroyBody(int id);
+    void clear();
+
+    RigidBody& body(int id) { return bodies[id]; }
+    const RigidBody& body(int id) const { return bodies[id]; }
+    void wake(int id);
+
+    void step(float dt);
+
+    // CCD za brzo telo: let tela id kroz sledeci korak dt protiv tela target. Ako ga dodirne, telo
+    // se pomera do trenutka udara kao da je step() trajao samo toliko (polozaj i brzina), a
+    // sledeci step(dt) ga integrise samo za ostatak koraka. Vraca vreme udara od pocetka koraka;
+    // bez udara se telo ne menja.
+    bool advanceToImpact(int id, int target, float dt, float& timeOfImpact);
+
+    // Da li su se tela dodirivala u poslednjem koraku
+    bool isTouching(int a, int b) const;
+    bool hasContacts(int id) const;
+    bool hasAwakeBodies() const { return awakeCount > 0; }
+    size_t getManifoldCount() const { return manifolds.size(); }
+};
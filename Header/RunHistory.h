@@ -0,0 +1,125 @@
+#pragma once
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ScoreStore.h"
+
+// Jedna zavrsena partija (POD - prolazi kroz SpscQueue bez alokacija)
+struct RunRecord {
+    char name[ScoreRecord::MAX_NAME_LENGTH + 1];   // "" = igrac nije uneo ime
+    long long timestampMs;            // Kraj partije
+    int score;
+    int durationMs;
+    int drops;                        // Pusteni blokovi
+    float meanOverhang;               // Prosecno prepustanje postavljenih blokova
+    float finalSwayAmplitude;         // Najveci otklon vrha zgrade tokom partije
+};
+
+// Istorija svih partija (RunHistory.bin), zapisana po kolonama u blokovima od BLOCK_RUNS partija:
+//     BlockHeader | imena | igrac | vreme | skor | trajanje | spustanja | prepustanje | njihanje
+// Svaka kolona je niz varint-ova: igrac je indeks u recnik imena bloka, vreme je razlika od
+// prethodne partije, prepustanje i njihanje su kvantizovani. Zaglavlje ima opseg vremena bloka,
+// pa upit "od datuma" preskace stare blokove bez citanja.
+// Partije dok se blok ne popuni idu red po red u "<istorija>.tail"; tail pamti duzinu istorije kada
+// je poceo, pa se posle prekida izmedju upisa bloka i praznjenja tail-a partije ne ponavljaju.
+class RunHistory {
+public:
+    static const uint32_t BLOCK_RUNS = 4096;
+
+    enum Column {
+        COLUMN_NAMES,
+        COLUMN_PLAYER,
+        COLUMN_TIMESTAMP,
+        COLUMN_SCORE,
+        COLUMN_DURATION,
+        COLUMN_DROPS,
+        COLUMN_OVERHANG,
+        COLUMN_SWAY,
+        COLUMN_COUNT
+    };
+
+    struct BlockHeader {
+        char magic[4];                // "KRUN"
+        uint32_t version;
+        uint32_t runCount;
+        uint32_t checksum;            // FNV-1a svih kolona
+        uint32_t columnBytes[COLUMN_COUNT];
+        int64_t minTimestampMs;
+        int64_t maxTimestampMs;
+    };
+
+    // Dekodiran blok; popunjene su samo trazene kolone (maska 1 << Column)
+    struct Block {
+        size_t count;
+        long long minTimestampMs;
+        long long maxTimestampMs;
+        std::vector<std::string> names;
+        std::vector<uint32_t> player;
+        std::vector<long long> timestampMs;
+        std::vector<int> score;
+        std::vector<int> durationMs;
+        std::vector<int> drops;
+        std::vector<float> meanOverhang;
+        std::vector<float> finalSwayAmplitude;
+    };
+
+private:
+    std::string historyPath;
+    std::string tailPath;
+    FILE* history;
+    FILE* tail;
+    long long historyEnd;             // Kraj poslednjeg ispravnog bloka
+    std::vector<RunRecord> tailRuns;  // Partije iz tail-a, za sledeci blok
+
+    bool resetTail();
+    bool sealBlock();
+
+public:
+    RunHistory() : history(nullptr), tail(nullptr), historyEnd(0) {}
+    ~RunHistory();
+
+    RunHistory(const RunHistory&) = delete;
+    RunHistory& operator=(const RunHistory&) = delete;
+
+    // Otvara (ili pravi) istoriju; odsecen poslednji blok i prekinuti redovi tail-a se odbacuju
+    bool open(const std::string& path);
+    void close();
+
+    // Red u tail (bafer); kada se skupi BLOCK_RUNS partija upisuju se kao blok
+    bool append(const RunRecord& run);
+    bool flush(bool sync);
+
+    bool isOpen() const { return history != nullptr; }
+};
+
+// Citanje istorije blok po blok - u memoriji je uvek samo jedan blok
+class RunHistoryReader {
+private:
+    FILE* file;
+    std::string tailPath;
+    long long position;
+    long long fileSize;
+    bool blocksDone;
+    bool tailDone;
+    std::vector<unsigned char> payload;
+
+public:
+    RunHistoryReader() : file(nullptr), position(0), fileSize(0), blocksDone(true), tailDone(true) {}
+    ~RunHistoryReader();
+
+    RunHistoryReader(const RunHistoryReader&) = delete;
+    RunHistoryReader& operator=(const RunHistoryReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    // Sledeci blok u kome ima partija od sinceMs; columns = maska (1 << RunHistory::Column).
+    // Partije iz tail-a stizu kao poslednji blok.
+    bool next(RunHistory::Block& block, unsigned columns, long long sinceMs = LLONG_MIN);
+};
+
+// Najbolji skor po igracu za partije od sinceMs (partije bez imena se ne racunaju), od najboljeg
+bool bestScoresSince(const std::string& historyPath, long long sinceMs, std::vector<std::pair<std::string, int> >& best);
@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// Rang lista za veliki broj igraca: B+ stablo sa brojem elemenata po podstablu
+// (order-statistic) + hes mapa ime -> kljuc.
+//   upis/izmena/brisanje po imenu  O(log n)
+//   rank / percentil igraca        O(log n)
+//   top k                          O(k)  (listovi su povezani)
+// Cvorovi imaju do 64 elementa, pa je stablo plitko (4 nivoa za 10M igraca) i svaki
+// nivo je jedan kontinualan niz - mnogo manje promasaja kesa nego kod skip liste.
+// Redosled: veci rezultat prvi; kod jednakih, igrac koji je ranije upisan.
+class ScoreIndex {
+private:
+    static const int LEAF_CAPACITY = 64;
+    static const int INNER_CAPACITY = 64;
+
+    struct Key {
+        int score;
+        uint32_t sequence;             // Redni broj prvog upisa igraca
+    };
+
+    struct Entry {
+        Key key;
+        const std::string* name;       // Kljuc iz hes mape (stabilna adresa)
+    };
+
+    struct Node {
+        bool leaf;
+        int count;                     // Broj elemenata (list) ili dece (unutrasnji cvor)
+    };
+
+    struct Leaf : Node {
+        Entry entries[LEAF_CAPACITY];
+        Leaf* previous;
+        Leaf* next;
+    };
+
+    struct Inner : Node {
+        Key maxKeys[INNER_CAPACITY];   // >= svih kljuceva u detetu i, < svih u desnijoj deci
+        uint32_t sizes[INNER_CAPACITY];// Broj igraca u podstablu deteta
+        Node* children[INNER_CAPACITY];
+    };
+
+    Node* root;
+    Leaf* firstLeaf;
+    size_t count;
+    uint32_t nextSequence;
+    std::unordered_map<std::string, Key> byName;
+
+    static bool before(const Key& a, const Key& b);
+    static int findChild(const Inner* inner, const Key& key);
+
+    Leaf* newLeaf();
+    Node* insertInto(Node* node, const Entry& entry, Key& splitMaxKey, uint32_t& splitSize);
+    bool eraseFrom(Node* node, const Key& key);
+    void unlinkLeaf(Leaf* leaf);
+    void freeTree(Node* node);
+    void insertEntry(const Entry& entry);
+    void eraseKey(const Key& key);
+    size_t rankOf(const Key& key) const;
+
+public:
+    ScoreIndex();
+    ~ScoreIndex();
+
+    ScoreIndex(const ScoreIndex&) = delete;
+    ScoreIndex& operator=(const ScoreIndex&) = delete;
+
+    // Upis ili zamena rezultata igraca (poslednji rezultat vazi)
+    void set(const std::string& name, int score);
+    bool erase(const std::string& name);
+    bool get(const std::string& name, int& score) const;
+    void clear();
+
+    // 0 = najbolji; -1 ako igrac ne postoji
+    long long rank(const std::string& name) const;
+    // Procenat igraca sa losijim plasmanom (0-100); -1 ako igrac ne postoji
+    double percentile(const std::string& name) const;
+
+    size_t size() const { return count; }
+
+    // Prvih k u redosledu rang liste; visitor(name, score)
+    template <typename Visitor>
+    void forEachTop(size_t k, Visitor visitor) const {
+        size_t visited = 0;
+        for (const Leaf* leaf = firstLeaf; leaf && visited < k; leaf = leaf->next) {
+            for (int i = 0; i < leaf->count && visited < k; i++, visited++) {
+                visitor(*leaf->entries[i].name, leaf->entries[i].key.score);
+            }
+        }
+    }
+
+    template <typename Visitor>
+    void forEach(Visitor visitor) const {
+        forEachTop(count, visitor);
+    }
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdio>
+#include <string>
+#include "Leaderboard.h"
+#include "ScoreStore.h"
+
+// Dnevnik rezultata (append-only) preko snapshot-a (ScoreStore, PlayersScore.bin).
+// Svaki sacuvan rezultat je jedna linija dodata na kraj dnevnika:
+//     score,timestampMs,checksum,ime\n
+// Kompakcija: aktivni dnevnik se preimenuje u "<dnevnik>.old", otvara se nov, zapisi iz ".old" se
+// upisuju u snapshot (O(1) po zapisu), snapshot se sinhronizuje na disk i tek onda se ".old" brise.
+// Pri pokretanju: snapshot, pa ".old" (ako je kompakcija prekinuta), pa aktivni dnevnik - ponovljeno
+// citanje ".old" preko novog snapshot-a daje isto stanje jer vazi poslednji rezultat.
+// Posle replay() klasu koristi samo jedna nit (ScorePersistence).
+class ScoreJournal {
+private:
+    ScoreStore& store;
+    std::string journalPath;
+    std::string compactingPath;       // journalPath + ".old"
+    FILE* journal;
+    size_t journalRecords;            // Zapisa u aktivnom dnevniku
+    size_t compactionThreshold;
+    bool pendingCompaction;           // ".old" je ostao od prekinute ili neuspele kompakcije
+
+    bool openJournal();
+
+public:
+    ScoreJournal(ScoreStore& store, const std::string& journalPath, size_t compactionThreshold = 64);
+    ~ScoreJournal();
+
+    ScoreJournal(const ScoreJournal&) = delete;
+    ScoreJournal& operator=(const ScoreJournal&) = delete;
+
+    // Ponavlja dnevnik(e) preko snapshot-a koji je leaderboard vec ucitao
+    void replay(Leaderboard& leaderboard);
+
+    // Upis u bafer dnevnika; na disk ide tek sa flush()
+    bool append(const ScoreRecord& record);
+    // sync = true: i fsync (podaci prezive i pad sistema, ne samo procesa)
+    bool flush(bool sync);
+
+    bool needsCompaction() const {
+        return store.isOpen() && (pendingCompaction || journalRecords >= compactionThreshold);
+    }
+    // Prenosi ".old" u snapshot (blokira - poziva se sa pozadinske niti)
+    bool compact();
+};
+
+// Dnevnik uz skladiste: "PlayersScore.bin" -> "PlayersScore.journal"
+std::string journalPathForStore(const std::string& storePath);
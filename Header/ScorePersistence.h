@@ -0,0 +1,66 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Leaderboard.h"
+#include "Options.h"
+#include "RunHistory.h"
+#include "ScoreJournal.h"
+#include "SpscQueue.h"
+
+// Upis rezultata na posebnoj I/O niti.
+// Igra samo ubaci (ime, skor, vreme) u red bez zakljucavanja i odmah nastavlja; radnik uzima sve
+// sto je stiglo, upisuje grupu u dnevnik jednim flush-om i radi kompakciju. shutdown() prazni red.
+// Zavrsene partije idu istim putem (svoj red) u istoriju partija.
+class ScorePersistence {
+private:
+    static const size_t QUEUE_CAPACITY = 256;
+    static const size_t RUN_QUEUE_CAPACITY = 64;
+
+    std::string storePath;
+    std::string csvImportPath;
+    ScoreStore store;
+    ScoreJournal journal;
+    SpscQueue<ScoreRecord, QUEUE_CAPACITY> queue;
+    std::string runHistoryPath;
+    RunHistory runHistory;
+    SpscQueue<RunRecord, RUN_QUEUE_CAPACITY> runQueue;
+    FsyncPolicy fsyncPolicy;
+    std::chrono::milliseconds fsyncInterval;
+
+    std::thread worker;
+    std::atomic<bool> stopping;
+    std::mutex wakeMutex;             // Samo za spavanje radnika, ne stiti red
+    std::condition_variable wake;
+    std::mutex spaceMutex;            // Samo za cekanje mesta u redu
+    std::condition_variable spaceAvailable;
+
+    void workerLoop();
+
+public:
+    // csvImportPath: stari CSV koji se uvozi ako binarni fajl jos ne postoji; runHistoryPath prazan = bez istorije
+    ScorePersistence(const std::string& storePath, const std::string& csvImportPath, const std::string& journalPath,
+        FsyncPolicy fsyncPolicy, int fsyncIntervalMs, const std::string& runHistoryPath = "");
+    ~ScorePersistence();
+
+    ScorePersistence(const ScorePersistence&) = delete;
+    ScorePersistence& operator=(const ScorePersistence&) = delete;
+
+    // Ucitava snapshot i dnevnik u leaderboard (sinhrono) i pokrece radnika
+    void start(Leaderboard& leaderboard);
+
+    // Poziva samo nit igre; ne blokira. false ako je red pun (rezultat se ne cuva)
+    bool submit(const std::string& name, int score);
+    // Isto, sa gotovim zapisom i bez poruke - pozivalac odlucuje sta radi kada je red pun
+    bool submit(const ScoreRecord& record);
+    // Posle false iz submit(): ceka da radnik isprazni deo reda (najduze do sledeceg budjenja radnika)
+    void waitForSpace();
+    // Zavrsena partija za istoriju; ne blokira
+    bool submitRun(const RunRecord& run);
+
+    // Ceka da se red isprazni i upise na disk, pa zaustavlja radnika
+    void shutdown();
+};
@@ -0,0 +1,109 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "MappedFile.h"
+
+// Jedan sacuvan rezultat (POD - prolazi kroz SpscQueue bez alokacija)
+struct ScoreRecord {
+    static const int MAX_NAME_LENGTH = 16;
+
+    char name[MAX_NAME_LENGTH + 1];
+    int score;
+    long long timestampMs;
+};
+
+// Binarni fajl rezultata (PlayersScore.bin) mapiran u memoriju:
+//     StoreHeader | StoreRecord[recordCapacity] | uint32 slots[hashCapacity]
+// Slotovi su hes indeks po imenu sa otvorenim adresiranjem (linearno probanje): 0 = prazan,
+// inace indeks zapisa + 1. Pretraga i izmena postojeceg igraca su O(1), bez parsiranja.
+// Kada se kapacitet popuni, pravi se nov fajl duplog kapaciteta i atomski zamenjuje stari.
+class ScoreStore {
+public:
+    // Kada isto ime vec postoji: poslednji upis (kao u igri) ili bolji rezultat
+    enum MergeRule {
+        MERGE_LATEST,
+        MERGE_BEST
+    };
+
+    struct StoreHeader {
+        char magic[4];                // "KSCR"
+        uint32_t version;
+        uint32_t recordCount;
+        uint32_t recordCapacity;
+        uint32_t hashCapacity;        // Stepen dvojke, 2 x recordCapacity
+        uint32_t reserved[3];
+    };
+
+    struct StoreRecord {
+        uint8_t nameLength;
+        char name[ScoreRecord::MAX_NAME_LENGTH];   // Bez '\0'
+        uint8_t padding[3];
+        int32_t score;
+        int64_t timestampMs;
+    };
+
+private:
+    static const uint32_t VERSION = 1;
+    static const uint32_t INITIAL_CAPACITY = 1024;
+
+    std::string filePath;
+    MappedFile file;
+
+    StoreHeader* header() const { return reinterpret_cast<StoreHeader*>(file.data()); }
+    StoreRecord* records() const { return reinterpret_cast<StoreRecord*>(file.data() + sizeof(StoreHeader)); }
+    uint32_t* slots() const {
+        return reinterpret_cast<uint32_t*>(file.data() + sizeof(StoreHeader) + header()->recordCapacity * sizeof(StoreRecord));
+    }
+
+    static size_t fileSize(uint32_t recordCapacity);
+    static uint32_t hashName(const char* name, size_t length);
+
+    bool validate() const;
+    bool rebuild(uint32_t recordCapacity);
+    // Slot sa ovim imenom, ili prazan slot gde bi ime trebalo upisati
+    uint32_t* findSlot(const char* name, size_t length, uint32_t hash) const;
+    bool upsertHashed(const char* name, size_t length, uint32_t hash, int score, long long timestampMs, MergeRule rule);
+
+public:
+    ScoreStore() {}
+
+    ScoreStore(const ScoreStore&) = delete;
+    ScoreStore& operator=(const ScoreStore&) = delete;
+
+    // Otvara fajl; ako ne postoji (ili je neispravan) pravi nov i uvozi CSV (ako je zadat)
+    bool open(const std::string& path, const std::string& csvImportPath);
+    void close();
+
+    // Uvoz CSV-a "ime,skor" u blokovima (CsvReader); vraca broj uvezenih linija ili -1
+    long long importCsv(const std::string& csvPath, MergeRule rule = MERGE_LATEST, long long* bytesRead = nullptr);
+
+    bool get(const std::string& name, int& score) const;
+    bool upsert(const char* name, int score, long long timestampMs);
+    // Ime duze od MAX_NAME_LENGTH se skracuje
+    bool upsert(const char* name, size_t length, int score, long long timestampMs, MergeRule rule);
+    // Isto kao upsert redom, ali se slotovi i zapisi cele grupe prvo ucitaju u kes (prefetch),
+    // pa se promasaji preklapaju umesto da se cekaju jedan po jedan
+    bool upsertBatch(const ScoreRecord* batch, size_t count, MergeRule rule);
+    bool flush(bool sync);
+
+    bool isOpen() const { return file.isOpen(); }
+    size_t size() const { return file.isOpen() ? header()->recordCount : 0; }
+
+    // visitor(const StoreRecord&) za svaki zapis, redom upisa
+    template <typename Visitor>
+    void forEachRecord(Visitor visitor) const {
+        if (!file.isOpen()) return;
+        const StoreRecord* record = records();
+        for (uint32_t i = 0; i < header()->recordCount; i++, record++) {
+            visitor(*record);
+        }
+    }
+
+    // visitor(ime, skor) za svaki zapis, redom upisa
+    template <typename Visitor>
+    void forEach(Visitor visitor) const {
+        forEachRecord([&visitor](const StoreRecord& record) {
+            visitor(std::string(record.name, record.nameLength), static_cast<int>(record.score));
+        });
+    }
+};
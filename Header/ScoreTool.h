@@ -0,0 +1,11 @@
+#pragma once
+#include "Options.h"
+
+// Alat za rezultate bez prozora (igra ne sme biti pokrenuta):
+//   Kostur.exe --import-scores=kiosk1.csv,kiosk2.csv [--merge=best] [--export-scores=sve.csv]
+// Uvoz i izvoz idu u blokovima, sa konstantnom memorijom; spajanje je po imenu igraca.
+int runScoreTool(const Options& options);
+
+// Najbolji rezultat po igracu iz istorije partija za poslednjih N dana:
+//   Kostur.exe --run-report[=7] [--run-history=RunHistory.bin]
+int runHistoryReport(const Options& options);
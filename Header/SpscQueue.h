@@ -0,0 +1,57 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// Red bez zakljucavanja za jednog proizvodjaca i jednog potrosaca (ring buffer).
+// Capacity mora biti stepen dvojke; u redu staje najvise Capacity - 1 elemenata.
+// Glava i rep su razdvojeni popunom da niti ne bi delile istu liniju kesa (bez alignas, jer
+// C++14 new ne garantuje poravnanje vece od podrazumevanog).
+template <typename T, size_t Capacity>
+class SpscQueue {
+private:
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity mora biti stepen dvojke");
+    static const size_t MASK = Capacity - 1;
+    static const size_t CACHE_LINE = 64;
+
+    char paddingBefore[CACHE_LINE];
+    std::atomic<size_t> head;                // Sledeci za citanje (potrosac)
+    char paddingHead[CACHE_LINE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> tail;                // Sledeci za upis (proizvodjac)
+    char paddingTail[CACHE_LINE - sizeof(std::atomic<size_t>)];
+    T items[Capacity];
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Samo nit proizvodjaca; false ako je red pun
+    bool tryPush(const T& item) {
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        size_t nextTail = (currentTail + 1) & MASK;
+        if (nextTail == head.load(std::memory_order_acquire)) return false;
+
+        items[currentTail] = item;
+        tail.store(nextTail, std::memory_order_release);
+        return true;
+    }
+
+    // Samo nit potrosaca; false ako je red prazan
+    bool tryPop(T& item) {
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) return false;
+
+        item = items[currentHead];
+        head.store((currentHead + 1) & MASK, std::memory_order_release);
+        return true;
+    }
+
+    bool full() const {
+        return ((tail.load(std::memory_order_acquire) + 1) & MASK) == head.load(std::memory_order_acquire);
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+};
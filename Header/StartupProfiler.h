@@ -0,0 +1,49 @@
+#pragma once
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Vremenska linija pokretanja igre (glfwInit, prozor, GLEW, VAO-i, sejderi, teksture, font).
+// Faze se mere sa begin/end (ili ProfileScope), a na kraju se izvoze kao Chrome trace JSON
+// (chrome://tracing, ui.perfetto.dev) i kao tabela u konzoli.
+class StartupProfiler {
+private:
+    struct Phase {
+        std::string name;
+        double startUs;
+        double durationUs;
+        int depth;
+    };
+
+    std::chrono::steady_clock::time_point origin;
+    std::vector<Phase> phases;
+    std::vector<size_t> openPhases;   // Indeksi faza koje jos traju (ugnjezdene)
+    double totalUs;
+    bool finished;
+
+    StartupProfiler();
+    double nowUs() const;
+
+public:
+    static StartupProfiler& instance();
+
+    void begin(const std::string& name);
+    void end();
+    void finish();                    // Kraj pokretanja - posle ovoga se nista ne meri
+
+    bool isFinished() const { return finished; }
+    double getTotalMs() const { return totalUs / 1000.0; }
+
+    bool writeChromeTrace(const char* filePath) const;
+    void printSummary() const;
+};
+
+// RAII faza - meri od konstrukcije do kraja opsega
+class ProfileScope {
+public:
+    explicit ProfileScope(const std::string& name) { StartupProfiler::instance().begin(name); }
+    ~ProfileScope() { StartupProfiler::instance().end(); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
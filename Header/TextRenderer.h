@@ -27,5 +27,7 @@ public:
     
     bool loadFont(const char* fontPath, unsigned int fontSize);
     void renderText(const std::string& text, float x, float y, float scale, float r, float g, float b);
+    void renderText(const char* text, float x, float y, float scale, float r, float g, float b);
     float getTextWidth(const std::string& text, float scale);
+    float getTextWidth(const char* text, float scale);
 };
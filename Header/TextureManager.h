@@ -0,0 +1,71 @@
+#pragma once
+#include <GL/glew.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Util.h"
+
+// Rezidencija opcionih tekstura (pozadine, dekoracije).
+// Tekstura se ucitava pri prvoj upotrebi ili unapred (prefetch) - dekodiranje ide na pozadinskoj
+// niti, a slanje na GPU u update() na OpenGL niti. Dok tekstura nije spremna get() vraca
+// providni placeholder. Kada zauzece predje budzet, izbacuju se najduze nekoriscene teksture.
+class TextureManager {
+private:
+    enum EntryState {
+        UNLOADED,
+        QUEUED,       // Ceka ili je na dekodiranju
+        DECODED,      // Pikseli spremni, ceka upload
+        RESIDENT      // Na GPU
+    };
+
+    struct Entry {
+        std::string path;
+        int maxWidth, maxHeight;
+        GLint wrapS, wrapT;
+        bool pinned;                  // Ne izbacuje se (npr. trenutna pozadina)
+        EntryState state;
+        ImagePixels pixels;
+        unsigned int texture;
+        size_t bytes;
+        unsigned long long lastUsedFrame;
+    };
+
+    std::vector<Entry> entries;
+    std::deque<int> decodeQueue;
+    std::mutex mutex;                 // Stiti state/pixels/decodeQueue
+    std::condition_variable decodeReady;
+    std::thread worker;
+    bool stopping;
+
+    unsigned int placeholderTexture;
+    size_t budgetBytes;
+    size_t residentBytes;
+    unsigned long long frame;
+
+    void workerLoop();
+    void requestLocked(int handle);
+    void upload(Entry& entry);
+    void evictOverBudget();
+
+public:
+    explicit TextureManager(size_t budgetBytes);
+    ~TextureManager();
+
+    // Vraca handle; maxWidth/maxHeight - najveca velicina na ekranu (0 = puna rezolucija)
+    int registerTexture(const std::string& path, int maxWidth, int maxHeight, GLint wrapS, GLint wrapT);
+
+    unsigned int get(int handle);     // GL tekstura ili placeholder; zahteva ucitavanje ako treba
+    void prefetch(int handle);        // Zapocni pozadinsko ucitavanje bez upotrebe
+    void loadNow(int handle);         // Sinhrono ucitavanje (za teksturu potrebnu u prvom frejmu)
+    void setPinned(int handle, bool pinned);
+    bool isResident(int handle);
+
+    void update(int maxUploads = 1);  // Samo na OpenGL niti: upload dekodiranih + izbacivanje
+    // Posle svih get() u nacrtanom frejmu; update() bez crtanja (cekanje) ne pomera LRU brojac
+    void endFrame();
+
+    size_t getResidentBytes() const { return residentBytes; }
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Stabilnost tornja od blokova iste visine; masa bloka je srazmerna sirini (odseceni blokovi su
+// laksi). Toranj se rusi kada teziste dela iznad nekog sprata k izadje iz dodira sa spratom ispod
+// (presek sirina blokova k-1 i k). Sa prefiksnim sumama S (zbir masa * x centra) i M (zbir masa),
+// teziste spratova k..n je (S_n - S_{k-1}) / (M_n - M_{k-1}), pa je uslov za levu ivicu L_k:
+//     S_n >= L_k * M_n + (S_{k-1} - L_k * M_{k-1})
+// tj. S_n mora biti iznad prave sprata k u tacki M_n - za sve spratove odjednom, iznad gornje
+// anvelope svih pravih (desna ivica je simetricna, donja anvelopa). Anvelope su Li Chao stabla
+// nad M (celobrojne jedinice mase), pa je dodavanje bloka O(log) umesto prolaska kroz sve spratove.
+class TowerStability {
+private:
+    // Gornja anvelopa pravih y = a*x + b nad celobrojnim x u [0, DOMAIN). Domen je fiksan i ogroman,
+    // a cvorovi nastaju tek kada zatrebaju (dubina je log2(DOMAIN), ne broj pravih)
+    class Envelope {
+    private:
+        struct Line {
+            double a, b;
+            long long floor;          // Sprat koji je dodao pravu (-1 = prazno)
+            double at(long long x) const { return a * static_cast<double>(x) + b; }
+        };
+        struct Node {
+            Line line;
+            int left, right;
+        };
+
+        std::vector<Node> nodes;      // nodes[0] je koren
+
+    public:
+        Envelope() { reset(); }
+        void reset();
+        void insert(double a, double b, long long floor);
+        // Najveca vrednost u tacki x i sprat kome pripada (-1 ako nema pravih)
+        double query(long long x, long long& floor) const;
+    };
+
+    Envelope leftEdges;               // max_k (L_k * x + ...)
+    Envelope rightEdges;              // -min_k (R_k * x + ...), prave su negirane
+    double sumX;                      // S_n
+    long long totalMass;              // M_n (jedinice mase, vidi MASS_SCALE)
+    long long count;                  // Broj spratova
+    float topLeft, topRight;          // Ivice poslednjeg bloka
+
+public:
+    TowerStability() { reset(); }
+
+    void reset();
+
+    // Dodaje blok na vrh (masa = sirina); false ako se toranj rusi (failedFloor = sprat cije je teziste izaslo iz
+    // oslonca; blok na zemlji se uvek drzi)
+    bool addBlock(float centerX, float width, long long& failedFloor);
+
+    long long size() const { return count; }
+    double getCenterOfMass() const { return totalMass > 0 ? sumX / static_cast<double>(totalMass) : 0.0; }
+};
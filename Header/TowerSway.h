@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Njihanje zgrade po spratovima: svaki sprat je jedinicna masa na opruzi sa prigusenjem prema
+// spratu ispod (sprat 0 prema zemlji). Opruga sprata je mekša sto je vise prepustanja
+// nagomilano do njega, pa klimava zgrada ima sporije i vece njihanje. Sila u opruzi i:
+//     f_i = k_i (x_i - x_{i-1}) + c_i (v_i - v_{i-1}),   a_i = f_{i+1} - f_i
+// Eksplicitni simplekticki Ojler po poljima (SoA) - oba prolaza su stencil bez zavisnosti
+// izmedju spratova, pa idu po 4 sprata (SSE). Korak se deli kada bi bio prevelik za najkrucu oprugu.
+class TowerSway {
+private:
+    // Indeks 0 je zemlja (uvek 0), spratovi su 1..n; iza poslednjeg ima mesta za celu grupu od 4
+    std::vector<float> offset;
+    std::vector<float> velocity;
+    std::vector<float> stiffness;
+    std::vector<float> damping;
+    std::vector<float> force;
+    size_t count;
+    float accumulatedOverhang;
+    float maxStiffness;
+    float peakTopOffset;              // Najveci |otklon| vrha od reset()
+
+    void reserveFloors(size_t floors);
+    void integrate(float dt);
+
+public:
+    TowerSway() { reset(); }
+
+    void reset();
+
+    // Nov sprat na vrhu; overhangRatio = prepustanje / sirina bloka
+    void addFloor(float overhangRatio);
+
+    // Trenutna promena brzine vrha (udar bloka van centra)
+    void kickTop(float deltaVelocity);
+
+    void step(float dt);
+
+    size_t size() const { return count; }
+    float getPeakTopOffset() const { return peakTopOffset; }
+    // count vrednosti, od prizemlja navise
+    const float* getOffsets() const { return offset.data() + 1; }
+    const float* getVelocities() const { return velocity.data() + 1; }
+};
@@ -0,0 +1,45 @@
+#pragma once
+#include <atomic>
+
+// Razmena stanja izmedju jednog pisca i jednog citaoca bez zakljucavanja. Pisac uvek ima svoj
+// slot za pisanje, citalac svoj za citanje, a treci je "srednji" - poslednji objavljen. publish()
+// i acquire() samo zamenjuju svoj slot sa srednjim (jedan atomic exchange), pa niko nikad ne ceka,
+// a citalac uvek dobija celo (nepocepano) i najnovije stanje. Slotovi se ponovo koriste, pa
+// vektori u T zadrzavaju kapacitet.
+template <typename T>
+class TripleBuffer {
+private:
+    static const unsigned FRESH = 4;          // Srednji slot je objavljen posle poslednjeg acquire()
+
+    T slots[3];
+    std::atomic<unsigned> middle;
+    unsigned writeIndex;                      // Samo nit pisca
+    unsigned readIndex;                       // Samo nit citaoca
+
+public:
+    TripleBuffer() : middle(1), writeIndex(0), readIndex(2) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Pisac: slot za sledece stanje (sadrzi neko starije stanje)
+    T& back() { return slots[writeIndex]; }
+
+    // Pisac: back() postaje najnovije stanje
+    void publish() {
+        writeIndex = middle.exchange(writeIndex | FRESH, std::memory_order_acq_rel) & ~FRESH;
+    }
+
+    // Citalac: prelazi na najnovije objavljeno stanje (ako ga ima); false = nista novo
+    bool acquire() {
+        if ((middle.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+        readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & ~FRESH;
+        return true;
+    }
+
+    // Citalac: da li acquire() ima nesto novo (bez prelaska)
+    bool hasFresh() const { return (middle.load(std::memory_order_relaxed) & FRESH) != 0; }
+
+    // Citalac: stanje iz poslednjeg acquire()
+    const T& front() const { return slots[readIndex]; }
+};
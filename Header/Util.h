@@ -2,7 +2,18 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <string>
+
+// Dekodirana slika (RGB/RGBA...), oslobadja se sa freeImagePixels
+struct ImagePixels {
+    unsigned char* data;
+    int width, height, channels;
+};
+
 int endProgram(std::string message);
 unsigned int createShader(const char* vsSource, const char* fsSource);
-unsigned loadImageToTexture(const char* filePath);
+// maxWidth/maxHeight > 0: slika se pre slanja na GPU smanjuje (box filter) na najvise tu velicinu
+bool loadImagePixels(const char* filePath, int maxWidth, int maxHeight, ImagePixels& image);
+void freeImagePixels(ImagePixels& image);
+unsigned uploadImageToTexture(const ImagePixels& image);
+unsigned loadImageToTexture(const char* filePath, int maxWidth = 0, int maxHeight = 0);
 GLFWcursor* loadImageToCursor(const char* filePath);
\ No newline at end of file
@@ -1,6 +1,7 @@
 #version 330 core
 
 in vec2 texCoord;
+in vec4 instanceColor;
 
 out vec4 outCol;
 
@@ -16,4 +17,5 @@ void main()
     } else {
         outCol = uColor;
     }
+    outCol *= instanceColor;
 }
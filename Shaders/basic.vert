@@ -2,14 +2,29 @@
 
 layout(location = 0) in vec2 inPos;
 layout(location = 1) in vec2 inTexCoord;
+// Samo za instancirano crtanje (uInstanced != 0)
+layout(location = 2) in vec4 inInstance;        // 1: x, y, velicina, providnost  2: x, y, sirina, visina
+layout(location = 3) in vec4 inInstanceColor;   // 2: mnozi uColor
+layout(location = 4) in float inInstanceOffset; // 2: pomeraj njihanja po x
 
 uniform mat4 uModel;
 uniform mat4 uProjection;
+uniform int uInstanced;
 
 out vec2 texCoord;
+out vec4 instanceColor;
 
 void main()
 {
-    gl_Position = uProjection * uModel * vec4(inPos, 0.0, 1.0);
+    vec2 worldPos = inPos;
+    instanceColor = vec4(1.0);
+    if (uInstanced == 1) {
+        worldPos = inInstance.xy + inPos * inInstance.z;
+        instanceColor.a = inInstance.w;
+    } else if (uInstanced == 2) {
+        worldPos = inInstance.xy + vec2(inInstanceOffset, 0.0) + inPos * inInstance.zw;
+        instanceColor = inInstanceColor;
+    }
+    gl_Position = uProjection * uModel * vec4(worldPos, 0.0, 1.0);
     texCoord = inTexCoord;
 }
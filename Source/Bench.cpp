@@ -0,0 +1,459 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../Header/Bench.h"
+#include "../Header/ScoreIndex.h"
+#include "../Header/LeaderboardServer.h"
+#include "../Header/ScoreJournal.h"
+#include "../Header/RunHistory.h"
+#include "../Header/TowerStability.h"
+#include "../Header/Physics2D.h"
+#include "../Header/ParticleSystem.h"
+#include "../Header/TowerSway.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock BenchClock;
+
+static double elapsedNs(BenchClock::time_point start) {
+    return std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+}
+
+static void report(const char* name, double totalNs, long long operations) {
+    printf("  %-28s %12.1f ns/op  %10.2f Mop/s  (%lld op, %.1f ms)\n",
+        name, totalNs / operations, operations * 1e3 / totalNs, operations, totalNs / 1e6);
+}
+
+// Rang lista sa N igraca: upis, izmena po imenu, top 3, rank i percentil
+static int benchLeaderboard(long long count) {
+    if (count <= 0) count = 10000000;
+    const long long queries = 1000000;
+
+    printf("Leaderboard benchmark: %lld igraca\n", count);
+
+    std::vector<std::string> names;
+    names.reserve(static_cast<size_t>(count));
+    char buffer[32];
+    for (long long i = 0; i < count; i++) {
+        snprintf(buffer, sizeof(buffer), "p%lld", i);
+        names.push_back(buffer);
+    }
+
+    std::mt19937 random(42u);
+    std::uniform_int_distribution<int> scoreDistribution(0, 5000);
+    ScoreIndex index;
+
+    BenchClock::time_point start = BenchClock::now();
+    for (long long i = 0; i < count; i++) {
+        index.set(names[i], scoreDistribution(random));
+    }
+    report("insert", elapsedNs(start), count);
+
+    std::uniform_int_distribution<long long> playerDistribution(0, count - 1);
+    start = BenchClock::now();
+    for (long long i = 0; i < queries; i++) {
+        index.set(names[playerDistribution(random)], scoreDistribution(random));
+    }
+    report("update by name", elapsedNs(start), queries);
+
+    long long checksum = 0;
+    start = BenchClock::now();
+    for (long long i = 0; i < queries; i++) {
+        index.forEachTop(3, [&checksum](const std::string&, int score) { checksum += score; });
+    }
+    report("top 3", elapsedNs(start), queries);
+
+    start = BenchClock::now();
+    for (long long i = 0; i < queries; i++) {
+        checksum += index.rank(names[playerDistribution(random)]);
+    }
+    report("rank", elapsedNs(start), queries);
+
+    double percentileSum = 0.0;
+    start = BenchClock::now();
+    for (long long i = 0; i < queries; i++) {
+        percentileSum += index.percentile(names[playerDistribution(random)]);
+    }
+    report("percentile", elapsedNs(start), queries);
+
+    printf("  (kontrolna suma %lld, prosecni percentil %.2f)\n", checksum, percentileSum / queries);
+    return 0;
+}
+
+// Jedna veza generatora opterecenja: perConnection rezultata u grupama od batchSize, uz cekanje ACK-a
+static bool submitLoad(int port, int connection, long long perConnection, int batchSize) {
+    SocketHandle socket = netConnectLoopback(port);
+    if (socket == INVALID_SOCKET_HANDLE) return false;
+
+    std::vector<unsigned char> request;
+    std::vector<unsigned char> response;
+    char name[32];
+    bool ok = true;
+    for (long long sent = 0; ok && sent < perConnection; ) {
+        int count = static_cast<int>(std::min<long long>(batchSize, perConnection - sent));
+        request.clear();
+        ByteWriter writer(request);
+        writer.u16(static_cast<uint16_t>(count));
+        for (int i = 0; i < count; i++, sent++) {
+            int length = snprintf(name, sizeof(name), "c%d_%lld", connection, sent % 50000);
+            writer.name(name, static_cast<size_t>(length));
+            writer.i32(static_cast<int32_t>(sent % 5000));
+            writer.i64(sent);
+        }
+
+        uint8_t type;
+        ok = sendFrame(socket, MSG_SUBMIT_BATCH, request) && receiveFrame(socket, type, response) && type == MSG_SUBMIT_ACK;
+    }
+    netClose(socket);
+    return ok;
+}
+
+static bool runServiceLoad(const char* label, const std::string& storePath, long long count, int connections, int batchSize) {
+    LeaderboardServer server(storePath, FSYNC_BATCH, 1000);
+    if (!server.start(0)) return false;
+
+    long long perConnection = count / connections;
+    std::vector<std::thread> threads;
+    std::vector<char> results(connections, 0);
+
+    BenchClock::time_point start = BenchClock::now();
+    for (int c = 0; c < connections; c++) {
+        threads.push_back(std::thread([&, c]() {
+            results[c] = submitLoad(server.getPort(), c, perConnection, batchSize) ? 1 : 0;
+        }));
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    double totalNs = elapsedNs(start);
+    server.stop();
+
+    for (char result : results) {
+        if (!result) {
+            std::cout << label << ": veza sa serverom nije uspela" << std::endl;
+            return false;
+        }
+    }
+    report(label, totalNs, perConnection * connections);
+    return true;
+}
+
+// Server rang liste na loopback-u: N rezultata kroz vise veza, pojedinacno i u grupama
+static int benchLeaderboardService(long long count) {
+    if (count <= 0) count = 200000;
+    const int connections = 4;
+    const std::string storePath = "bench_leaderboard.bin";
+
+    if (!netInit()) return -1;
+    printf("Leaderboard service benchmark: %lld rezultata, %d veze\n", count, connections);
+
+    // Pojedinacni zahtevi su spori (jedan obilazak po rezultatu), pa ih ima manje
+    bool ok = runServiceLoad("batch 1 (memorija)", "", count / 10, connections, 1)
+        && runServiceLoad("batch 64 (memorija)", "", count, connections, 64)
+        && runServiceLoad("batch 1024 (memorija)", "", count, connections, MAX_SUBMIT_BATCH)
+        && runServiceLoad("batch 64 (dnevnik, fsync)", storePath, count, connections, 64);
+
+    std::string journalPath = journalPathForStore(storePath);
+    remove(storePath.c_str());
+    remove(journalPath.c_str());
+    remove((journalPath + ".old").c_str());
+
+    netShutdown();
+    return ok ? 0 : -1;
+}
+
+// Istorija od N partija (50k igraca, 60 dana): upis, velicina fajla i "najbolji po igracu ove nedelje"
+static int benchRunHistory(long long count) {
+    if (count <= 0) count = 2000000;
+    const int players = 50000;
+    const long long dayMs = 24LL * 60 * 60 * 1000;
+    const std::string path = "bench_runs.bin";
+    remove(path.c_str());
+    remove((path + ".tail").c_str());
+
+    printf("Run history benchmark: %lld partija, %d igraca\n", count, players);
+
+    std::mt19937 random(42u);
+    std::uniform_int_distribution<int> playerDistribution(0, players - 1);
+    std::uniform_int_distribution<int> scoreDistribution(0, 60);
+    std::uniform_real_distribution<float> overhangDistribution(0.0f, 0.33f);
+    long long nowMs = 1700000000000LL;
+    long long stepMs = 60 * dayMs / count;
+
+    RunHistory history;
+    if (!history.open(path)) return -1;
+
+    BenchClock::time_point start = BenchClock::now();
+    RunRecord run;
+    for (long long i = 0; i < count; i++) {
+        snprintf(run.name, sizeof(run.name), "p%d", playerDistribution(random));
+        run.timestampMs = nowMs - 60 * dayMs + i * stepMs;
+        run.score = scoreDistribution(random);
+        run.durationMs = 5000 + run.score * 1800;
+        run.drops = run.score + 1;
+        run.meanOverhang = overhangDistribution(random);
+        run.finalSwayAmplitude = run.meanOverhang * run.score * 0.05f;
+        history.append(run);
+    }
+    history.flush(true);
+    history.close();
+    report("append", elapsedNs(start), count);
+
+    FILE* file = fopen(path.c_str(), "rb");
+    long long bytes = 0;
+    if (file) {
+        fseek(file, 0, SEEK_END);
+        bytes = ftell(file);
+        fclose(file);
+    }
+    printf("  velicina: %.1f MB, %.2f B/partija (RunRecord u memoriji: %d B)\n", bytes / 1e6, static_cast<double>(bytes) / count,
+        static_cast<int>(sizeof(RunRecord)));
+
+    std::vector<std::pair<std::string, int> > best;
+    start = BenchClock::now();
+    bestScoresSince(path, nowMs - 7 * dayMs, best);
+    report("best per player, 7 dana", elapsedNs(start), count * 7 / 60);
+    printf("  (%zu igraca, najbolji %s %d)\n", best.size(), best.empty() ? "-" : best[0].first.c_str(), best.empty() ? 0 : best[0].second);
+
+    start = BenchClock::now();
+    bestScoresSince(path, LLONG_MIN, best);
+    report("best per player, sve", elapsedNs(start), count);
+
+    remove(path.c_str());
+    remove((path + ".tail").c_str());
+    return 0;
+}
+
+// Isti toranj kroz model i kroz direktan prolaz (teziste svakog gornjeg dela, masa = sirina);
+// vraca da li se slazu u tome kada se toranj rusi
+static bool stabilityMatchesScan(const std::vector<float>& centers, const std::vector<float>& widths) {
+    TowerStability stability;
+    for (size_t n = 0; n < centers.size(); n++) {
+        long long failedFloor;
+        bool standing = stability.addBlock(centers[n], widths[n], failedFloor);
+
+        long long scanFloor = -1;
+        double sum = 0.0, mass = 0.0;
+        for (size_t k = n; k >= 1; k--) {
+            sum += static_cast<double>(widths[k]) * centers[k];
+            mass += widths[k];
+            double center = sum / mass;
+            double left = std::max(centers[k] - widths[k] / 2.0, centers[k - 1] - widths[k - 1] / 2.0);
+            double right = std::min(centers[k] + widths[k] / 2.0, centers[k - 1] + widths[k - 1] / 2.0);
+            if (center < left - 1e-9 || center > right + 1e-9) scanFloor = static_cast<long long>(k);
+        }
+        if (standing != (scanFloor < 0)) {
+            printf("  (model i prolaz se razlikuju na %zu. bloku: model %s, prolaz sprat %lld)\n",
+                n + 1, standing ? "stoji" : "rusi", scanFloor);
+            return false;
+        }
+        if (!standing) {
+            printf("  (provera: rusenje na %zu. bloku, sprat %lld)\n", n + 1, failedFloor);
+            return true;
+        }
+    }
+    return true;
+}
+
+// Toranj od N spratova: provera stabilnosti po bloku (Li Chao) naspram prolaska kroz sve spratove
+static int benchTowerStability(long long count) {
+    if (count <= 0) count = 1000000;
+    const float width = 0.25f;
+
+    printf("Tower stability benchmark: %lld spratova\n", count);
+
+    // Nasumicno njihanje oko ose - toranj se ne rusi, pa se meri ceo
+    std::mt19937 random(42u);
+    std::uniform_real_distribution<float> offsetDistribution(-0.03f, 0.03f);
+    std::vector<float> centers(static_cast<size_t>(count));
+    for (long long i = 0; i < count; i++) {
+        centers[i] = offsetDistribution(random);
+    }
+
+    TowerStability stability;
+    long long collapses = 0;
+    long long failedFloor;
+    BenchClock::time_point start = BenchClock::now();
+    for (long long i = 0; i < count; i++) {
+        if (!stability.addBlock(centers[i], width, failedFloor)) collapses++;
+    }
+    report("addBlock", elapsedNs(start), count);
+    printf("  (rusenja: %lld, teziste %.4f)\n", collapses, stability.getCenterOfMass());
+
+    // Isto pitanje bez prefiksnih suma: teziste svakog gornjeg dela od vrha nadole, O(n) po bloku
+    long long naive = std::min(count, 20000LL);
+    start = BenchClock::now();
+    long long naiveCollapses = 0;
+    for (long long n = 1; n < naive; n++) {
+        double sum = 0.0;
+        for (long long k = n; k >= 1; k--) {
+            sum += centers[k];
+            double center = sum / (n - k + 1);
+            double left = std::max(centers[k], centers[k - 1]) - width / 2.0;
+            double right = std::min(centers[k], centers[k - 1]) + width / 2.0;
+            if (center < left || center > right) {
+                naiveCollapses++;
+                break;
+            }
+        }
+    }
+    report("naive scan (prvih 20k)", elapsedNs(start), naive);
+
+    // Regresija: prava sprata 1 je dodata kada je toranj bio nizak, a obara ga tek posle 1024 spratova
+    std::vector<float> leaning(1, 0.0f);
+    leaning.resize(1501, 0.45f);
+    leaning.resize(4000, 0.9f);
+    bool matches = stabilityMatchesScan(leaning, std::vector<float>(leaning.size(), 1.0f));
+    // Uski blokovi gore su laksi: sa jednakim masama ovaj toranj bi pao ranije
+    std::vector<float> tapered(1, 0.0f), taperedWidths(1, 1.0f);
+    for (int i = 1; i < 3000; i++) {
+        tapered.push_back(i <= 50 ? 0.3f : 0.6f);
+        taperedWidths.push_back(i <= 50 ? 1.0f : 0.1f);
+    }
+    matches = stabilityMatchesScan(tapered, taperedWidths) && matches;
+    return collapses == 0 && naiveCollapses == 0 && matches ? 0 : -1;
+}
+
+// N blokova pada na zemlju i na toranj od 1000 statickih spratova: korak dok se sve ne umiri, pa
+// korak kada su svi uspavani (ostrva spavaju - treba da bude skoro besplatan)
+static int benchPhysics(long long count) {
+    if (count <= 0) count = 200;
+    const float step = 1.0f / 120.0f;
+    const float half = 0.125f;
+    const int floors = 1000;
+
+    printf("Physics benchmark: %lld blokova, %d statickih spratova\n", count, floors);
+
+    PhysicsWorld world;
+    world.setGravity(Vec2(0.0f, -9.81f));
+    world.createBody(Vec2(0.0f, -50.0f), Vec2(100.0f, 50.0f), 0.0f);
+    // Toranj je desno od gomile, visok - kao u igri, vecina tela je staticka
+    for (int i = 0; i < floors; i++) {
+        world.createBody(Vec2(20.0f, half + 2.0f * half * i), Vec2(half, half), 0.0f);
+    }
+    std::mt19937 random(42u);
+    std::uniform_real_distribution<float> angleDistribution(-0.5f, 0.5f);
+    const int columns = 16;
+    for (long long i = 0; i < count; i++) {
+        float x = (static_cast<float>(i % columns) - columns / 2.0f) * 3.0f * half;
+        float y = half + 3.0f * half * static_cast<float>(i / columns);
+        world.createBody(Vec2(x, y), Vec2(half, half), 1.0f, angleDistribution(random));
+    }
+
+    const long long maxSteps = 120 * 120;
+    long long steps = 0;
+    BenchClock::time_point start = BenchClock::now();
+    while (world.hasAwakeBodies() && steps < maxSteps) {
+        world.step(step);
+        steps++;
+    }
+    report("step (gomila se slaze)", elapsedNs(start), steps);
+    printf("  (umireno posle %lld koraka = %.1f s simulacije, kontakata %zu)\n",
+        steps, steps * step, world.getManifoldCount());
+
+    const long long idleSteps = 100000;
+    start = BenchClock::now();
+    for (long long i = 0; i < idleSteps; i++) {
+        world.step(step);
+    }
+    report("step (sve spava)", elapsedNs(start), idleSteps);
+
+    // Jedan blok pada na vrh tornja - slucaj iz igre
+    int falling = world.createBody(Vec2(20.05f, 2.0f * half * floors + 1.0f), Vec2(half, half), 1.0f);
+    world.body(falling).velocity = Vec2(0.0f, -1.2f);
+    long long fallSteps = 0;
+    start = BenchClock::now();
+    while (world.hasAwakeBodies() && fallSteps < maxSteps) {
+        world.step(step);
+        fallSteps++;
+    }
+    report("step (blok na tornju)", elapsedNs(start), fallSteps);
+    return steps < maxSteps && fallSteps < maxSteps ? 0 : -1;
+}
+
+// N zivih cestica prasine: update po frejmu (integracija + niz instanci za GPU). Mrtve cestice
+// se dopunjavaju van merenja, pa je u svakom frejmu ziv ceo bazen.
+static int benchParticles(long long count) {
+    if (count <= 0) count = 100000;
+    const float frameStep = 1.0f / 120.0f;
+    const int frames = 1000;
+
+    printf("Particles benchmark: %lld zivih cestica, %d frejmova\n", count, frames);
+
+    ParticleSystem dust(static_cast<size_t>(count));
+    double updateNs = 0.0;
+    for (int frame = 0; frame < frames; frame++) {
+        while (static_cast<long long>(dust.getCount()) < count) {
+            long long missing = count - static_cast<long long>(dust.getCount());
+            dust.emitDust(0.1f * (frame % 8), 0.0f, 0.25f, static_cast<int>(std::min(missing, 1000LL)), 3.0f);
+        }
+        BenchClock::time_point start = BenchClock::now();
+        dust.update(frameStep);
+        updateNs += elapsedNs(start);
+    }
+    report("update (frejm)", updateNs, frames);
+    report("update (cestica)", updateNs, count * frames);
+    printf("  (budzet 1 ms po frejmu: %s)\n", updateNs / frames < 1e6 ? "da" : "PREKORACEN");
+    return 0;
+}
+
+// Njihanje zgrade od N spratova (podrazumevano 1k, 100k i 1M): korak simulacije posle udara u vrh
+static int benchTowerSway(long long count) {
+    const float step = 1.0f / 120.0f;
+    std::vector<long long> sizes;
+    if (count > 0) {
+        sizes.push_back(count);
+    } else {
+        sizes.push_back(1000);
+        sizes.push_back(100000);
+        sizes.push_back(1000000);
+    }
+
+    printf("Tower sway benchmark: korak %.4f s\n", step);
+
+    std::mt19937 random(42u);
+    std::uniform_real_distribution<float> overhangDistribution(0.0f, 0.0005f);
+    bool finite = true;
+    for (long long floors : sizes) {
+        TowerSway sway;
+        for (long long i = 0; i < floors; i++) {
+            sway.addFloor(overhangDistribution(random));
+        }
+        sway.kickTop(0.5f);
+
+        long long steps = std::max(10LL, 100000000LL / floors);
+        BenchClock::time_point start = BenchClock::now();
+        for (long long i = 0; i < steps; i++) {
+            sway.step(step);
+        }
+        double totalNs = elapsedNs(start);
+
+        char label[64];
+        snprintf(label, sizeof(label), "step (%lld spratova)", floors);
+        report(label, totalNs, steps);
+        report("  po spratu", totalNs, steps * floors);
+        float top = sway.getOffsets()[sway.size() - 1];
+        finite = finite && std::isfinite(top);
+        printf("  (%lld koraka, pomeraj vrha %.5f)\n", steps, top);
+    }
+    return finite ? 0 : -1;
+}
+
+int runBenchmark(const Options& options) {
+    if (options.bench == "leaderboard") return benchLeaderboard(options.benchCount);
+    if (options.bench == "leaderboard-service") return benchLeaderboardService(options.benchCount);
+    if (options.bench == "run-history") return benchRunHistory(options.benchCount);
+    if (options.bench == "tower-stability") return benchTowerStability(options.benchCount);
+    if (options.bench == "physics") return benchPhysics(options.benchCount);
+    if (options.bench == "particles") return benchParticles(options.benchCount);
+    if (options.bench == "tower-sway") return benchTowerSway(options.benchCount);
+
+    std::cout << "Nepoznat benchmark: " << options.bench << std::endl;
+    std::cout << "Dostupni: leaderboard, leaderboard-service, run-history, tower-stability, physics, particles, tower-sway" << std::endl;
+    return -1;
+}
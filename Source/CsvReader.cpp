@@ -0,0 +1,115 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../Header/CsvReader.h"
+#include <climits>
+#include <cstring>
+#include <iostream>
+
+CsvReader::CsvReader(size_t bufferSize)
+    : file(nullptr), buffer(bufferSize), begin(0), end(0), endOfFile(false), bytesRead(0), skippedLines(0)
+{
+}
+
+CsvReader::~CsvReader() {
+    close();
+}
+
+bool CsvReader::open(const std::string& path) {
+    close();
+    file = fopen(path.c_str(), "rb");
+    if (!file) {
+        std::cerr << "Ne mogu da otvorim fajl: " << path << std::endl;
+        return false;
+    }
+    begin = end = 0;
+    endOfFile = false;
+    bytesRead = 0;
+    skippedLines = 0;
+    return true;
+}
+
+void CsvReader::close() {
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+// Nedovrsena linija se pomera na pocetak bafera, ostatak se dopunjava iz fajla
+bool CsvReader::refill() {
+    if (endOfFile) return false;
+
+    if (begin > 0) {
+        memmove(buffer.data(), buffer.data() + begin, end - begin);
+        end -= begin;
+        begin = 0;
+    }
+
+    size_t read = fread(buffer.data() + end, 1, buffer.size() - end, file);
+    end += read;
+    bytesRead += static_cast<long long>(read);
+    if (read == 0) endOfFile = true;
+    return read > 0;
+}
+
+bool CsvReader::next(const char*& name, size_t& nameLength, int& score) {
+    if (!file) return false;
+
+    while (true) {
+        const char* line = buffer.data() + begin;
+        const char* lineEnd = static_cast<const char*>(memchr(line, '\n', end - begin));
+
+        if (!lineEnd) {
+            if (begin == 0 && end == buffer.size()) {
+                // Linija duza od bafera - preskace se do sledeceg '\n'
+                skippedLines++;
+                const char* newline = nullptr;
+                while (!newline) {
+                    begin = end = 0;
+                    if (!refill()) return false;
+                    newline = static_cast<const char*>(memchr(buffer.data(), '\n', end));
+                }
+                begin = newline - buffer.data() + 1;
+                continue;
+            }
+            if (refill()) continue;
+            if (begin == end) return false;
+
+            // Poslednja linija bez '\n' (refill ju je pomerio na pocetak bafera)
+            line = buffer.data() + begin;
+            lineEnd = buffer.data() + end;
+        }
+
+        begin = (lineEnd - buffer.data()) + (lineEnd < buffer.data() + end ? 1 : 0);
+
+        const char* last = lineEnd;
+        if (last > line && last[-1] == '\r') last--;
+        if (last == line) continue;   // Prazna linija
+
+        const char* comma = static_cast<const char*>(memchr(line, ',', last - line));
+        if (!comma || comma == line) {
+            skippedLines++;
+            continue;
+        }
+
+        // Skor: opcioni znak + cifre; ostatak linije (dodatne kolone) se ignorise
+        const char* digit = comma + 1;
+        bool negative = digit < last && *digit == '-';
+        if (negative) digit++;
+        if (digit == last || *digit < '0' || *digit > '9') {
+            skippedLines++;
+            continue;
+        }
+
+        long long value = 0;
+        while (digit < last && *digit >= '0' && *digit <= '9') {
+            if (value <= INT_MAX) value = value * 10 + (*digit - '0');
+            digit++;
+        }
+        if (value > INT_MAX) value = INT_MAX;
+
+        name = line;
+        nameLength = comma - line;
+        score = static_cast<int>(negative ? -value : value);
+        return true;
+    }
+}
@@ -0,0 +1,98 @@
+#include "../Header/FramePacer.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "Winmm.lib")
+#endif
+
+// Najmanji i najveci prag za prelazak sa spavanja na yield
+static const double MIN_SPIN_US = 500.0;
+static const double MAX_SPIN_US = 4000.0;
+static const double SLACK_DECAY = 0.995;
+
+FramePacer::FramePacer(double targetFps)
+    : frameInterval(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFps))),
+    started(false), sleepSlackUs(1000.0), histogram(BUCKET_COUNT, 0), frames(0), missedDeadlines(0), sumUs(0.0), maxUs(0.0)
+{
+#ifdef _WIN32
+    // Podrazumevana rezolucija tajmera je ~15.6 ms - sleep_for bi bio beskoristan
+    timeBeginPeriod(1);
+#endif
+}
+
+FramePacer::~FramePacer() {
+#ifdef _WIN32
+    timeEndPeriod(1);
+#endif
+}
+
+void FramePacer::wait() {
+    Clock::time_point now = Clock::now();
+    if (!started) {
+        started = true;
+        deadline = now + frameInterval;
+        lastFrame = now;
+        return;
+    }
+
+    if (now > deadline) {
+        missedDeadlines++;
+        // Vise od celog frejma kasnjenja: novi rok od sada, bez niza ubrzanih frejmova da se "stigne"
+        if (now - deadline > frameInterval) deadline = now;
+    }
+    else {
+        double spinUs = std::min(std::max(sleepSlackUs + 200.0, MIN_SPIN_US), MAX_SPIN_US);
+        Clock::time_point sleepUntil = deadline - std::chrono::microseconds(static_cast<long long>(spinUs));
+        if (now < sleepUntil) {
+            std::this_thread::sleep_for(sleepUntil - now);
+
+            double lateUs = std::chrono::duration<double, std::micro>(Clock::now() - sleepUntil).count();
+            sleepSlackUs = std::max(sleepSlackUs * SLACK_DECAY, lateUs);
+        }
+        while (Clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+    }
+
+    now = Clock::now();
+    double intervalUs = std::chrono::duration<double, std::micro>(now - lastFrame).count();
+    lastFrame = now;
+    deadline += frameInterval;
+
+    int bucket = std::min(static_cast<int>(intervalUs / BUCKET_US), BUCKET_COUNT - 1);
+    histogram[bucket]++;
+    frames++;
+    sumUs += intervalUs;
+    maxUs = std::max(maxUs, intervalUs);
+}
+
+void FramePacer::printReport() const {
+    if (frames == 0) return;
+
+    // Percentil iz histograma (gornja granica korpe)
+    auto percentileMs = [this](double fraction) {
+        long long target = static_cast<long long>(fraction * frames);
+        long long seen = 0;
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            seen += histogram[i];
+            if (seen > target) return (i + 1) * BUCKET_US / 1000.0;
+        }
+        return BUCKET_COUNT * BUCKET_US / 1000.0;
+    };
+
+    double targetMs = std::chrono::duration<double, std::milli>(frameInterval).count();
+    std::cout << "\n=== FRAME PACING ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2)
+              << "Frejmova: " << frames << ", cilj " << targetMs << " ms, prosek " << sumUs / frames / 1000.0 << " ms" << std::endl
+              << "p50 " << percentileMs(0.50) << " ms, p90 " << percentileMs(0.90) << " ms, p99 " << percentileMs(0.99)
+              << " ms, p99.9 " << percentileMs(0.999) << " ms, najduzi " << maxUs / 1000.0 << " ms" << std::endl
+              << "Propusteni rokovi: " << missedDeadlines << " (" << (100.0 * missedDeadlines / frames) << "%)" << std::endl;
+    std::cout << std::defaultfloat;
+}
@@ -0,0 +1,106 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../Header/FrameTelemetry.h"
+#include <cstdio>
+#include <iostream>
+
+// Isti redosled kao GameState i FrameTelemetry::Metric
+static const char* STATE_NAMES[FrameTelemetry::STATE_COUNT] = { "PLAYING", "GAME_OVER" };
+static const char* METRIC_NAMES[FrameTelemetry::METRIC_COUNT] = { "frame", "update", "render", "input" };
+
+FrameTelemetry::FrameTelemetry(const std::string& path, int intervalSeconds)
+    : outputPath(path), interval(std::chrono::seconds(intervalSeconds)), windowStart(Clock::now())
+{
+    if (!outputPath.empty()) {
+        FILE* file = fopen(outputPath.c_str(), "rb");
+        bool exists = file != nullptr;
+        if (file) fclose(file);
+
+        if (!exists && (file = fopen(outputPath.c_str(), "wb")) != nullptr) {
+            fputs("timestampMs,scope,state,metric,count,p50Us,p95Us,p99Us,maxUs\n", file);
+            fclose(file);
+        }
+    }
+}
+
+// Jedan red po stanju i metrici: timestampMs,scope,state,metric,count,p50,p95,p99,max
+bool FrameTelemetry::writeRows(const char* scope, HdrHistogram (&histograms)[STATE_COUNT][METRIC_COUNT]) const {
+    if (outputPath.empty()) return true;
+
+    FILE* file = fopen(outputPath.c_str(), "ab");
+    if (!file) {
+        std::cerr << "Ne mogu da upisem telemetriju: " << outputPath << std::endl;
+        return false;
+    }
+
+    long long nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    for (int s = 0; s < STATE_COUNT; s++) {
+        for (int m = 0; m < METRIC_COUNT; m++) {
+            const HdrHistogram& histogram = histograms[s][m];
+            if (histogram.getCount() == 0) continue;
+            fprintf(file, "%lld,%s,%s,%s,%lld,%lld,%lld,%lld,%lld\n", nowMs, scope, STATE_NAMES[s], METRIC_NAMES[m],
+                histogram.getCount(), histogram.percentile(0.50), histogram.percentile(0.95),
+                histogram.percentile(0.99), histogram.getMax());
+        }
+    }
+    return fclose(file) == 0;
+}
+
+void FrameTelemetry::printTable(const char* title, HdrHistogram (&histograms)[STATE_COUNT][METRIC_COUNT]) const {
+    printf("%s\n  %-10s %-7s %8s %9s %9s %9s %9s\n", title, "stanje", "metrika", "uzoraka", "p50 ms", "p95 ms", "p99 ms", "max ms");
+    for (int s = 0; s < STATE_COUNT; s++) {
+        for (int m = 0; m < METRIC_COUNT; m++) {
+            const HdrHistogram& histogram = histograms[s][m];
+            if (histogram.getCount() == 0) continue;
+            printf("  %-10s %-7s %8lld %9.2f %9.2f %9.2f %9.2f\n", STATE_NAMES[s], METRIC_NAMES[m], histogram.getCount(),
+                histogram.percentile(0.50) / 1000.0, histogram.percentile(0.95) / 1000.0,
+                histogram.percentile(0.99) / 1000.0, histogram.getMax() / 1000.0);
+        }
+    }
+}
+
+// Kopija ide u vec alociran niz (vector::operator= zadrzava kapacitet)
+void FrameTelemetry::copyLocked(HdrHistogram (&histograms)[STATE_COUNT][METRIC_COUNT]) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int s = 0; s < STATE_COUNT; s++) {
+        for (int m = 0; m < METRIC_COUNT; m++) {
+            copy[s][m] = histograms[s][m];
+        }
+    }
+}
+
+void FrameTelemetry::tick() {
+    Clock::time_point now = Clock::now();
+    if (now - windowStart < interval) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int s = 0; s < STATE_COUNT; s++) {
+            for (int m = 0; m < METRIC_COUNT; m++) {
+                copy[s][m] = window[s][m];
+                window[s][m].reset();
+            }
+        }
+    }
+    writeRows("window", copy);
+    windowStart = now;
+}
+
+void FrameTelemetry::printReport() {
+    double windowSeconds = std::chrono::duration<double>(Clock::now() - windowStart).count();
+    printf("\n=== TELEMETRIJA FREJMA ===\n");
+    char title[64];
+    snprintf(title, sizeof(title), "Poslednjih %.0f s:", windowSeconds);
+    copyLocked(window);
+    printTable(title, copy);
+    copyLocked(total);
+    printTable("Od pokretanja:", copy);
+    fflush(stdout);
+}
+
+void FrameTelemetry::finish() {
+    copyLocked(window);
+    writeRows("window", copy);
+    copyLocked(total);
+    writeRows("total", copy);
+}
@@ -1,5 +1,10 @@
 ﻿#include "../Header/Game.h"
 #include "../Header/Util.h"
+#include "../Header/StartupProfiler.h"
+#include "../Header/FramePacer.h"
+#include "../Header/FrameTelemetry.h"
+#include "../Header/Logger.h"
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <ctime>
@@ -13,43 +18,271 @@
 #define M_PI 3.14159265358979323846
 #endif
 
-Game::Game()
+Game::Game(int width, int height, const Options& options)
     : state(PLAYING), currentBlock(nullptr), blockFalling(false),
     swingAngle(0.0f), swingSpeed(2.0f), swingRadius(0.4f),
-    fallSpeed(1.2f), buildingSwayAngle(0.0f), buildingSwaySpeed(0.0f),
-    buildingSwayAmplitude(0.0f), score(0), cameraY(0.0f), targetCameraY(0.0f),
+    fallSpeed(1.2f), score(0), cameraY(0.0f), targetCameraY(0.0f),
     aspectRatio(1.0f), groundTexture(0), ropeTexture(0), blockTexture(0), backgroundTexture(0),
-    textRenderer(nullptr), windowWidth(1920), windowHeight(1080), textShaderProgram(0)
+    textRenderer(nullptr), windowWidth(width), windowHeight(height), textShaderProgram(0),
+    textureQuality(options.textureQuality), textureManager(nullptr),
+    textureBudgetBytes((size_t)options.textureBudgetMb * 1024 * 1024), backgroundIndex(BACKGROUND_COUNT - 1),
+    treeHandle(-1), benchHandle(-1), castleHandle(-1), scorePersistence(options.scoreStorePath, "PlayersScore.csv", journalPathForStore(options.scoreStorePath),
+        options.scoreFsync, options.scoreFsyncIntervalMs, options.runHistoryPath),
+    runStartTime(glfwGetTime()), runEndTime(0.0), runDrops(0), runOverhangSum(0.0f), runOverhangCount(0), runRecorded(false),
+    leaderboardClient(nullptr), remoteTopVersion(0), simulationRunning(false), simulationTelemetry(nullptr),
+    blockSpawned(false), motionReset(false), simulationStep(0), lastStepTime(0.0), publishedState(PLAYING), replayingInput(false), inputSequence(0), stepHadInput(false),
+    pinnedBackground(BACKGROUND_COUNT - 1), renderCameraY(0.0f), shownInputSequence(0), newInputShown(false), texturesPending(false)
 {
-    srand(static_cast<unsigned int>(time(nullptr)));
+    // Seme se pamti u zapisu ulaza, pa pustanje zapisa dobija iste blokove
+    unsigned int seed = static_cast<unsigned int>(time(nullptr));
+    if (!options.inputReplayPath.empty()) {
+        replayingInput = inputLog.load(options.inputReplayPath, seed);
+    }
+    else if (!options.inputRecordPath.empty()) {
+        inputLog.openRecord(options.inputRecordPath, seed);
+    }
+    randomState = seed * 2654435761u | 1u;   // Rasipa bliska semena (vreme u sekundama); nikad 0
+    inputTiming.inputTime = inputTiming.consumedTime = inputTiming.publishedTime = 0.0;
 
     // Inicijalizuj projection matricu kao identity matricu
     for (int i = 0; i < 16; i++) {
         projectionMatrix[i] = (i % 5 == 0) ? 1.0f : 0.0f;
     }
+    setAspectRatio((float)width, (float)height);
 
     initOpenGL();
     initTextRenderer();
+    scorePersistence.start(leaderboard);
+    remoteTopScores.count = 0;
+    if (options.leaderboardPort && netInit()) {
+        leaderboardClient = new LeaderboardClient(options.leaderboardPort);
+        leaderboardClient->start();
+    }
+    resetPhysics();
     spawnNewBlock();
 }
 
 Game::~Game() {
     if (currentBlock) delete currentBlock;
     if (textRenderer) delete textRenderer;
+    if (textureManager) delete textureManager;
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
     glDeleteVertexArrays(1, &ropeVAO);
     glDeleteBuffers(1, &ropeVBO);
     glDeleteVertexArrays(1, &blockVAO);
     glDeleteBuffers(1, &blockVBO);
+    glDeleteVertexArrays(1, &particleVAO);
+    glDeleteBuffers(1, &particleVBO);
+    glDeleteVertexArrays(1, &towerVAO);
+    glDeleteBuffers(1, &towerInstanceVBO);
+    glDeleteBuffers(1, &towerOffsetVBO);
     glDeleteVertexArrays(1, &backgroundVAO);
     glDeleteBuffers(1, &backgroundVBO);
     glDeleteProgram(shaderProgram);
     if (textShaderProgram) glDeleteProgram(textShaderProgram);
 }
 
+void Game::shutdown() {
+    stopSimulation();
+    if (state == GAME_OVER && !runRecorded) recordRun("");
+    scorePersistence.shutdown();
+    if (leaderboardClient) {
+        leaderboardClient->stop();
+        delete leaderboardClient;
+        leaderboardClient = nullptr;
+        netShutdown();
+    }
+}
+
 GameState Game::getGameState() const {
-    return state;
+    return snapshots.front().state;
+}
+
+void Game::startSimulation(FrameTelemetry* telemetry) {
+    if (simulationRunning) return;
+    simulationTelemetry = telemetry;
+    // Prvi snapshot pre pokretanja niti - render nikad ne crta prazno stanje
+    stepStartMotion = captureMotion();
+    publishSnapshot();
+    simulationRunning = true;
+    simulationThread = std::thread(&Game::simulationLoop, this);
+}
+
+void Game::stopSimulation() {
+    if (!simulationRunning) return;
+    {
+        std::lock_guard<std::mutex> lock(inputWakeMutex);
+        simulationRunning = false;
+    }
+    inputWake.notify_one();
+    simulationThread.join();
+    inputLog.close();
+}
+
+bool Game::postInput(InputEvent::Type type, int key, unsigned int codepoint) {
+    InputEvent event;
+    event.type = type;
+    event.key = key;
+    event.codepoint = codepoint;
+    event.timestamp = glfwGetTime();
+    event.stepOffsetUs = 0;
+    if (inputQueue.tryPush(event)) {
+        // Prazan lock: simulacija ne moze da propusti signal izmedju provere reda i cekanja
+        { std::lock_guard<std::mutex> lock(inputWakeMutex); }
+        inputWake.notify_one();
+        return true;
+    }
+    LOG_WARN("Red ulaza je pun - dogadjaj odbacen");
+    return false;
+}
+
+// Stalni korak: fizika ne zavisi od brzine rendera, a spor frejm (tekst, I/O) ne koci simulaciju
+void Game::simulationLoop() {
+    FramePacer pacer(SIMULATION_RATE);
+    const float step = static_cast<float>(1.0 / SIMULATION_RATE);
+
+    bool settled = false;
+
+    while (simulationRunning.load(std::memory_order_acquire)) {
+        // Kraj igre: update() ne menja nista, pa posle jednog mirnog koraka nit spava do ulaza
+        if (settled && !inputLog.isReplaying()) {
+            std::unique_lock<std::mutex> lock(inputWakeMutex);
+            inputWake.wait_for(lock, std::chrono::milliseconds(IDLE_WAKE_MS),
+                [this] { return !inputQueue.empty() || !simulationRunning; });
+            lock.unlock();
+            pacer.resume();
+            if (inputQueue.empty()) continue;
+        }
+
+        std::chrono::steady_clock::time_point stepStart = std::chrono::steady_clock::now();
+        GameState stepState = state;
+        bool hadInput = false;
+        stepStartMotion = captureMotion();
+
+        InputEvent event;
+        if (inputLog.isReplaying()) {
+            // Dok traje zapis, ulaz sa tastature/misa se odbacuje
+            while (inputQueue.tryPop(event)) {}
+            while (inputLog.nextDue(simulationStep, event)) {
+                applyInput(event);
+            }
+        }
+        else {
+            while (inputQueue.tryPop(event)) {
+                // Celi mikrosekundi - pustanje zapisa racuna sa istim brojem
+                double offset = (event.timestamp - lastStepTime) * 1000000.0;
+                if (offset > 1000000.0) offset = 1000000.0;
+                if (offset < -1000000.0) offset = -1000000.0;
+                event.stepOffsetUs = static_cast<int>(floor(offset + 0.5));
+                if (simulationTelemetry) {
+                    long long latencyUs = static_cast<long long>((glfwGetTime() - event.timestamp) * 1000000.0);
+                    simulationTelemetry->record(state, FrameTelemetry::METRIC_INPUT, latencyUs);
+                }
+                if (!stepHadInput) {
+                    stepHadInput = true;
+                    inputTiming.inputTime = event.timestamp;
+                    inputTiming.consumedTime = glfwGetTime();
+                }
+                inputLog.record(simulationStep, event);
+                applyInput(event);
+                hadInput = true;
+            }
+        }
+        update(step);
+        simulationStep++;
+        publishSnapshot();
+        settled = stepState == GAME_OVER && state == GAME_OVER && !hadInput && !physics.hasAwakeBodies();
+
+        if (simulationTelemetry) {
+            long long us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - stepStart).count();
+            simulationTelemetry->record(stepState, FrameTelemetry::METRIC_UPDATE, us);
+        }
+        pacer.wait();
+    }
+}
+
+void Game::applyInput(const InputEvent& event) {
+    switch (event.type) {
+    case InputEvent::DROP:
+        dropBlock(event.stepOffsetUs);
+        break;
+    case InputEvent::RESTART:
+        restart();
+        break;
+    case InputEvent::KEY:
+        onKeyPressed(event.key);
+        break;
+    case InputEvent::CHAR:
+        onCharEntered(event.codepoint);
+        break;
+    }
+}
+
+MotionState Game::captureMotion() const {
+    MotionState motion;
+    motion.cameraY = cameraY;
+    motion.swingAngle = swingAngle;
+    motion.blockX = currentBlock ? currentBlock->x : 0.0f;
+    motion.blockY = currentBlock ? currentBlock->y : 0.0f;
+    motion.blockAngle = blockAngle;
+    return motion;
+}
+
+// Kopira se u slot koji render trenutno ne koristi; vektor zgrade zadrzava kapacitet
+void Game::publishSnapshot() {
+    GameSnapshot& snapshot = snapshots.back();
+    snapshot.state = state;
+    snapshot.score = score;
+    snapshot.motion = captureMotion();
+    snapshot.previousMotion = stepStartMotion;
+    // Skok (restart, nov blok ispod kuke) se ne razvlaci preko koraka
+    if (motionReset) {
+        snapshot.previousMotion = snapshot.motion;
+    }
+    else if (blockSpawned) {
+        snapshot.previousMotion.blockX = snapshot.motion.blockX;
+        snapshot.previousMotion.blockY = snapshot.motion.blockY;
+        snapshot.previousMotion.blockAngle = snapshot.motion.blockAngle;
+        snapshot.previousMotion.swingAngle = snapshot.motion.swingAngle;
+    }
+    blockSpawned = false;
+    motionReset = false;
+    snapshot.stepTime = lastStepTime = glfwGetTime();
+    if (stepHadInput) {
+        stepHadInput = false;
+        inputSequence++;
+        inputTiming.publishedTime = snapshot.stepTime;
+    }
+    snapshot.inputSequence = inputSequence;
+    snapshot.inputTiming = inputTiming;
+    snapshot.blockFalling = blockFalling;
+    snapshot.hasCurrentBlock = currentBlock != nullptr;
+    if (currentBlock) snapshot.currentBlock = *currentBlock;
+    // Korak kosta O(novih spratova), ne O(zgrade)
+    if (snapshot.towerGeneration != towerGeneration || snapshot.tower.size() > placedBlocks.size()) {
+        snapshot.tower.clear();
+        snapshot.towerGeneration = towerGeneration;
+    }
+    snapshot.tower.insert(snapshot.tower.end(), placedBlocks.begin() + snapshot.tower.size(), placedBlocks.end());
+    size_t swayFloors = std::min(sway.size(), static_cast<size_t>(SWAY_VISIBLE_FLOORS));
+    snapshot.swayFirstFloor = sway.size() - swayFloors;
+    snapshot.swayOffsets.assign(sway.getOffsets() + snapshot.swayFirstFloor, sway.getOffsets() + sway.size());
+    snapshot.swayVelocities.assign(sway.getVelocities() + snapshot.swayFirstFloor, sway.getVelocities() + sway.size());
+    snapshot.enteringName = enteringName;
+    snapshot.playerName = playerName;
+    snapshot.backgroundIndex = backgroundIndex;
+    snapshot.topScores = leaderboard.getTopScores();
+    snapshot.debris.clear();
+    for (size_t i = 0; i < debris.size(); i++) {
+        snapshot.debris.push_back(debris[i].view);
+    }
+    std::copy(impacts, impacts + GameSnapshot::IMPACT_HISTORY, snapshot.impacts);
+    snapshot.impactSequence = impactSequence;
+    snapshots.publish();
+    // Render na ekranu kraja igre ceka u glfwWaitEventsTimeout - probudi ga da nacrta novo stanje
+    if (state == GAME_OVER || publishedState == GAME_OVER) glfwPostEmptyEvent();
+    publishedState = state;
 }
 
 // setAspectRatio - Normalizuje dimenzije za razli?ite ekrane
@@ -113,8 +346,17 @@ void Game::setAspectRatio(float width, float height) {
     }
 }
 
-void Game::preprocessTexture(unsigned int& texture, const char* filepath) {
-    texture = loadImageToTexture(filepath);
+// screenWidth/screenHeight - najveca velicina jednog ponavljanja teksture na ekranu u pikselima
+void Game::preprocessTexture(unsigned int& texture, const char* filepath, float screenWidth, float screenHeight) {
+    ProfileScope scope(std::string("texture: ") + filepath);
+
+    int maxWidth = 0;
+    int maxHeight = 0;
+    if (textureQuality > 0.0f) {
+        maxWidth = std::max(1, (int)ceil(screenWidth * textureQuality));
+        maxHeight = std::max(1, (int)ceil(screenHeight * textureQuality));
+    }
+    texture = loadImageToTexture(filepath, maxWidth, maxHeight);
 
     if (texture == 0) {
         std::cout << "GREŠKA: Tekstura nije ucitana: " << filepath << std::endl;
@@ -157,7 +399,11 @@ void Game::preprocessTexture(unsigned int& texture, const char* filepath) {
 }
 
 void Game::initOpenGL() {
+    StartupProfiler& profiler = StartupProfiler::instance();
+    ProfileScope initScope("initOpenGL");
+
     // GLAVNI VAO - za blokove i zemlju
+    profiler.begin("VAO: glavni");
     float vertices[] = {
         -0.5f, -0.5f,   0.0f,   0.0f,   // Donji levi
          0.5f, -0.5f,   50.0f,  0.0f,   // Donji desni (50x ponavljanje horizontalno)
@@ -182,8 +428,10 @@ void Game::initOpenGL() {
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
+    profiler.end();
 
     //  ROPE VAO - za konopac sa vertikalnim ponavljanjem teksture
+    profiler.begin("VAO: konopac");
     float ropeVertices[] = {
         -0.5f, -0.5f,   0.0f,   0.0f,   // Donji levi
          0.5f, -0.5f,   1.0f,   0.0f,   // Donji desni (1x horizontalno - clamp)
@@ -208,8 +456,10 @@ void Game::initOpenGL() {
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
+    profiler.end();
 
     // BLOCK VAO - za blokove sa 1x1 teksturom
+    profiler.begin("VAO: blok");
     float blockVertices[] = {
         // Pozicija      UV koordinate
         // X      Y       U       V
@@ -236,8 +486,63 @@ void Game::initOpenGL() {
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
+    profiler.end();
+
+    // PARTICLE VAO - kvad bloka + po instanci (x, y, velicina, providnost) iz bafera prasine
+    profiler.begin("VAO: prasina");
+    glGenVertexArrays(1, &particleVAO);
+    glGenBuffers(1, &particleVBO);
+
+    glBindVertexArray(particleVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, blockVBO);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, particleVBO);
+    glBufferData(GL_ARRAY_BUFFER, dust.getCapacity() * ParticleSystem::INSTANCE_FLOATS * sizeof(float), nullptr, GL_STREAM_DRAW);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, ParticleSystem::INSTANCE_FLOATS * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    profiler.end();
+
+    // TOWER VAO - kvad bloka + po spratu (x, y, sirina, visina), boja i pomeraj njihanja.
+    // Baferi dobijaju prostor u drawTower() kada zgrada poraste.
+    profiler.begin("VAO: zgrada");
+    glGenVertexArrays(1, &towerVAO);
+    glGenBuffers(1, &towerInstanceVBO);
+    glGenBuffers(1, &towerOffsetVBO);
+
+    glBindVertexArray(towerVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, blockVBO);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, towerInstanceVBO);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, TOWER_INSTANCE_FLOATS * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, TOWER_INSTANCE_FLOATS * sizeof(float), (void*)(4 * sizeof(float)));
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, towerOffsetVBO);
+    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)0);
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    profiler.end();
 
     // BACKGROUND VAO - puna pokrivka ekrana (fiksna pozadina)
+    profiler.begin("VAO: pozadina");
     float backgroundVertices[] = {
         // Pozicija (pokriva ceo ekran)  UV koordinate
         // X      Y       U       V
@@ -264,16 +569,61 @@ void Game::initOpenGL() {
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
+    profiler.end();
 
     shaderProgram = createShader("Shaders/basic.vert", "Shaders/basic.frag");
 
-    preprocessTexture(backgroundTexture, "Textures/background4.jpg");
-    preprocessTexture(groundTexture, "Textures/pixel-ground.png");
-    preprocessTexture(ropeTexture, "Textures/rope.png");
-    preprocessTexture(blockTexture, "Textures/block2.png");
+    // Velicine na ekranu izvedene iz projekcije i skaliranja kvadova u render()/drawRope()
+    float pixelsPerUnit = (aspectRatio > 1.0f ? windowHeight : windowWidth) / 2.0f;
+    float groundHeight = GROUND_Y - (-1.0f);
+
+    preprocessTexture(groundTexture, "Textures/pixel-ground.png",
+        2.0f * pixelsPerUnit, groundHeight * pixelsPerUnit);                // 100 jedinica / 50 ponavljanja
+    preprocessTexture(ropeTexture, "Textures/rope.png",
+        ROPE_WIDTH * pixelsPerUnit, ROPE_LENGTH / 10.0f * pixelsPerUnit);   // 10 ponavljanja duz uzeta
+    preprocessTexture(blockTexture, "Textures/block2.png",
+        BLOCK_WIDTH * pixelsPerUnit, BLOCK_HEIGHT * pixelsPerUnit);
+
+    initTextureManager();
+}
+
+void Game::initTextureManager() {
+    ProfileScope scope("initTextureManager");
+
+    textureManager = new TextureManager(textureBudgetBytes);
+
+    float pixelsPerUnit = (aspectRatio > 1.0f ? windowHeight : windowWidth) / 2.0f;
+    auto screenSize = [this](float size) {
+        return textureQuality > 0.0f ? std::max(1, (int)ceil(size * textureQuality)) : 0;
+    };
+
+    // Kvad pozadine je +-10 * (aspect * 0.1, 0.1)
+    const char* backgrounds[BACKGROUND_COUNT] = {
+        "Textures/background.jpg", "Textures/background2.jpg", "Textures/background3.jpg", "Textures/background4.jpg"
+    };
+    for (int i = 0; i < BACKGROUND_COUNT; i++) {
+        backgroundHandles[i] = textureManager->registerTexture(backgrounds[i],
+            screenSize(2.0f * aspectRatio * pixelsPerUnit), screenSize(2.0f * pixelsPerUnit),
+            GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+    }
+
+    treeHandle = textureManager->registerTexture("Textures/tree.png",
+        screenSize(TREE_WIDTH * pixelsPerUnit), screenSize(TREE_HEIGHT * pixelsPerUnit), GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+    benchHandle = textureManager->registerTexture("Textures/bench.png",
+        screenSize(BENCH_WIDTH * pixelsPerUnit), screenSize(BENCH_HEIGHT * pixelsPerUnit), GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+    castleHandle = textureManager->registerTexture("Textures/castle.png",
+        screenSize(CASTLE_WIDTH * pixelsPerUnit), screenSize(CASTLE_HEIGHT * pixelsPerUnit), GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+
+    // Prva pozadina mora biti spremna za prvi frejm, ostalo se ucitava u pozadini
+    textureManager->setPinned(backgroundHandles[backgroundIndex], true);
+    textureManager->loadNow(backgroundHandles[backgroundIndex]);
+    textureManager->prefetch(treeHandle);
+    textureManager->prefetch(benchHandle);
+    textureManager->prefetch(castleHandle);
 }
 
 void Game::initTextRenderer() {
+    ProfileScope scope("initTextRenderer");
     std::cout << "\n=== INICIJALIZACIJA TEXT RENDERER-A ===" << std::endl;
 
     textShaderProgram = createShader("Shaders/text.vert", "Shaders/text.frag");
@@ -299,7 +649,10 @@ void Game::setWindowSize(int width, int height) {
 }
 
 float Game::getRandomColor() {
-    return 0.3f + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / 0.7f));
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return 0.3f + 0.7f * ((randomState >> 8) * (1.0f / 16777216.0f));
 }
 
 void Game::spawnNewBlock() {
@@ -314,17 +667,22 @@ void Game::spawnNewBlock() {
     float initialX = 0.0f;                              // Centralno ispod kuke
     float initialY = (HOOK_Y + cameraY) - ROPE_LENGTH;  // Na dužini užeta ispod kuke u world space
 
+    // Sirina vrha zgrade - odlomljeni visak se ne vraca
+    float width = placedBlocks.empty() ? BLOCK_WIDTH : placedBlocks.back().width;
+
     currentBlock = new Block(
         initialX, 
         initialY,
-        BLOCK_WIDTH,
+        width,
         BLOCK_HEIGHT,
         r, g, b
     );
 
     blockFalling = false;
+    blockAngle = 0.0f;
     swingAngle = 0.0f;
     swingSpeed = 2.0f;
+    blockSpawned = true;
 }
 
 void Game::updateCamera(float deltaTime) {
@@ -356,62 +714,198 @@ void Game::updateCamera(float deltaTime) {
     cameraY += (targetCameraY - cameraY) * CAMERA_SPEED * deltaTime;
 }
 
+// Model klatna; deltaTime moze biti i negativan (vracanje unazad u dropBlock)
+void Game::advanceSwing(float deltaTime) {
+    float angularAcceleration = -(GRAVITY / ROPE_LENGTH) * sin(swingAngle);
+    swingSpeed += angularAcceleration * deltaTime;
+
+    //AŽURIRAJ UGAO
+    swingAngle += swingSpeed * deltaTime;
+
+    //OGRANICENIE SA BLAGIM USPORAVANJEM
+    if (swingAngle > MAX_SWING_ANGLE) {
+        swingAngle = MAX_SWING_ANGLE;     // Postavi na granicu
+        swingSpeed = -swingSpeed;         // Okreni smer (ide nazad)
+    }
+    else if (swingAngle < -MAX_SWING_ANGLE) {
+        swingAngle = -MAX_SWING_ANGLE;    // Postavi na granicu
+        swingSpeed = -swingSpeed;         // Okreni smer (ide nazad)
+    }
+
+    // IZRACUNAJ POZICIJU BLOKA 
+    float pivotX = 0.0f;
+    float pivotY = HOOK_Y + cameraY;  // Pivot se pomera sa kamerom u world space
+
+    currentBlock->x = pivotX + ROPE_LENGTH * sin(swingAngle);
+    currentBlock->y = pivotY - ROPE_LENGTH * cos(swingAngle);
+}
+
+void Game::resetPhysics() {
+    physics.clear();
+    physics.setGravity(Vec2(0.0f, -GRAVITY));
+    // Zemlja: siroka ploca cija je gornja ivica GROUND_Y
+    groundBody = physics.createBody(Vec2(0.0f, GROUND_Y - 50.0f), Vec2(100.0f, 50.0f), 0.0f);
+    fallingBody = -1;
+    towerBodies.clear();
+    debris.clear();
+    blockAngle = 0.0f;
+    fallingSpeed = 0.0f;
+    fallingTouching = false;
+}
+
+static float speedOf(const RigidBody& body) {
+    return sqrtf(body.velocity.x * body.velocity.x + body.velocity.y * body.velocity.y);
+}
+
+// Korak fizike: blok koji pada (i posle kraja igre, dok se prevrce) i krhotine prate svoja tela.
+// Prvi dodir tela koje se krece dovoljno brzo je udar.
+void Game::stepPhysics(float deltaTime) {
+    for (size_t i = 0; i < debris.size(); i++) {
+        DebrisView& view = debris[i].view;
+        view.previousX = view.block.x;
+        view.previousY = view.block.y;
+        view.previousAngle = view.angle;
+    }
+    if (!physics.hasAwakeBodies()) return;
+
+    if (fallingBody >= 0) fallingSpeed = speedOf(physics.body(fallingBody));
+    for (size_t i = 0; i < debris.size(); i++) {
+        debris[i].speed = speedOf(physics.body(debris[i].body));
+    }
+
+    physics.step(deltaTime);
+
+    if (fallingBody >= 0) {
+        const RigidBody& body = physics.body(fallingBody);
+        currentBlock->x = body.position.x;
+        currentBlock->y = body.position.y;
+        blockAngle = body.angle;
+        // Udar bloka na toranj se prijavljuje pri postavljanju; ovde samo posle kraja igre
+        bool touching = physics.hasContacts(fallingBody);
+        if (state == GAME_OVER && touching && !fallingTouching && fallingSpeed > MIN_IMPACT_SPEED) {
+            addImpact(currentBlock->x, currentBlock->y - currentBlock->height / 2.0f, currentBlock->width, fallingSpeed);
+        }
+        fallingTouching = touching;
+    }
+
+    for (size_t i = 0; i < debris.size(); i++) {
+        DebrisPiece& piece = debris[i];
+        const RigidBody& body = physics.body(piece.body);
+        piece.view.block.x = body.position.x;
+        piece.view.block.y = body.position.y;
+        piece.view.angle = body.angle;
+        bool touching = physics.hasContacts(piece.body);
+        if (touching && !piece.touching && piece.speed > MIN_IMPACT_SPEED) {
+            addImpact(body.position.x, body.position.y - piece.view.block.height / 2.0f, piece.view.block.width, piece.speed);
+        }
+        piece.touching = touching;
+    }
+}
+
+// Deo bloka koji ostaje posle odlamanja: strana koja viri preko osnove vise od MIN_DEBRIS_WIDTH
+// se sece na ivicu osnove
+void Game::supportedSpan(const Block& base, float& left, float& right) const {
+    left = currentBlock->x - currentBlock->width / 2.0f;
+    right = currentBlock->x + currentBlock->width / 2.0f;
+    float baseLeft = base.x - base.width / 2.0f;
+    float baseRight = base.x + base.width / 2.0f;
+    if (baseLeft - left > MIN_DEBRIS_WIDTH) left = baseLeft;
+    if (right - baseRight > MIN_DEBRIS_WIDTH) right = baseRight;
+}
+
+// Blok ostaje samo iznad osnove, a visak sa svake strane postaje krhotina
+void Game::breakOffOverhang(const Block& base) {
+    float left, right;
+    supportedSpan(base, left, right);
+    float blockLeft = currentBlock->x - currentBlock->width / 2.0f;
+    float blockRight = currentBlock->x + currentBlock->width / 2.0f;
+    if (left > blockLeft) spawnDebris(blockLeft, left, -1.0f);
+    if (right < blockRight) spawnDebris(right, blockRight, 1.0f);
+    currentBlock->x = (left + right) / 2.0f;
+    currentBlock->width = right - left;
+}
+
+// direction: -1 = leva strana, 1 = desna; krhotina se blago odgurne od zgrade
+void Game::spawnDebris(float left, float right, float direction) {
+    if (static_cast<int>(debris.size()) >= MAX_DEBRIS) {
+        physics.destroyBody(debris.front().body);
+        debris.erase(debris.begin());
+    }
+
+    float width = right - left;
+    float x = (left + right) / 2.0f;
+    Block block(x, currentBlock->y, width, currentBlock->height, currentBlock->r, currentBlock->g, currentBlock->b);
+    DebrisView view = { block, 0.0f, x, currentBlock->y, 0.0f };
+    int body = physics.createBody(Vec2(x, currentBlock->y), Vec2(width / 2.0f, currentBlock->height / 2.0f), 1.0f);
+    physics.body(body).velocity = Vec2(direction * DEBRIS_KICK, 0.0f);
+    // Dodiruje blok pored sebe - prvi udar je tek kada padne na nesto
+    DebrisPiece piece = { body, true, 0.0f, view };
+    debris.push_back(piece);
+}
+
+void Game::addImpact(float x, float y, float width, float strength) {
+    ImpactEvent& impact = impacts[impactSequence % GameSnapshot::IMPACT_HISTORY];
+    impact.x = x;
+    impact.y = y;
+    impact.width = width;
+    impact.strength = strength;
+    impactSequence++;
+}
+
+// Postavljen blok postaje staticko telo novog sprata
+void Game::freezeFallingBlock() {
+    physics.destroyBody(fallingBody);
+    fallingBody = -1;
+    towerBodies.push_back(physics.createBody(Vec2(currentBlock->x, currentBlock->y),
+        Vec2(currentBlock->width / 2.0f, currentBlock->height / 2.0f), 0.0f));
+}
+
+// Blok koji pada se pre koraka provlaci kroz ceo pomeraj koraka (CCD): dodir sa zemljom ili
+// vrhom se resava u trenutku udara, pa ni veliki korak ni velika brzina ne prolaze kroz sprat.
+// fallingSpeed je brzina u tom trenutku. Blok koji se ne postavi stepPhysics() pomera samo za
+// ostatak koraka.
+bool Game::sweepFallingBlock(int target, float deltaTime) {
+    float timeOfImpact;
+    if (fallingBody < 0 || !physics.advanceToImpact(fallingBody, target, deltaTime, timeOfImpact)) return false;
+    const RigidBody& body = physics.body(fallingBody);
+    currentBlock->x = body.position.x;
+    currentBlock->y = body.position.y;
+    blockAngle = body.angle;
+    fallingSpeed = speedOf(body);
+    fallingTouching = true;   // Udar je prijavljen ovde, ne ponovo u stepPhysics()
+    return true;
+}
+
 void Game::update(float deltaTime) {
     static GameState lastState = PLAYING;
     if (state != lastState) {
-        std::cout << "\n?? STATUS PROMENJEN: "
-            << (lastState == PLAYING ? "PLAYING" : "GAME_OVER")
-            << " -> "
-            << (state == PLAYING ? "PLAYING" : "GAME_OVER") << std::endl;
+        LOG_DEBUG("Status promenjen: %s -> %s",
+            lastState == PLAYING ? "PLAYING" : "GAME_OVER", state == PLAYING ? "PLAYING" : "GAME_OVER");
         lastState = state;
     }
 
     if (state == GAME_OVER) {
         enteringName = true;
-        double now = glfwGetTime();
-        if (now - lastCursorBlink > 0.5) {
-            cursorVisible = !cursorVisible;
-            lastCursorBlink = now;
-        }
+        stepPhysics(deltaTime);
         return;
     }
 
     updateCamera(deltaTime);
 
     if (!blockFalling) {
-        float angularAcceleration = -(GRAVITY / ROPE_LENGTH) * sin(swingAngle);
-        swingSpeed += angularAcceleration * deltaTime;
-
-        //AŽURIRAJ UGAO
-        swingAngle += swingSpeed * deltaTime;
-
-        //OGRANICENIE SA BLAGIM USPORAVANJEM
-        if (swingAngle > MAX_SWING_ANGLE) {
-            swingAngle = MAX_SWING_ANGLE;     // Postavi na granicu
-            swingSpeed = -swingSpeed;         // Okreni smer (ide nazad)
-        }
-        else if (swingAngle < -MAX_SWING_ANGLE) {
-            swingAngle = -MAX_SWING_ANGLE;    // Postavi na granicu
-            swingSpeed = -swingSpeed;         // Okreni smer (ide nazad)
-        }
-
-        // IZRACUNAJ POZICIJU BLOKA 
-        float pivotX = 0.0f;
-        float pivotY = HOOK_Y + cameraY;  // Pivot se pomera sa kamerom u world space
-
-        currentBlock->x = pivotX + ROPE_LENGTH * sin(swingAngle);
-        currentBlock->y = pivotY - ROPE_LENGTH * cos(swingAngle);
-
+        advanceSwing(deltaTime);
     }
     else {
-        // Padanje bloka
-        currentBlock->y -= fallSpeed * deltaTime;
-
         // Provera da li je blok stigao do zemlje
         if (placedBlocks.empty()) {
-            if (currentBlock->y - currentBlock->height / 2.0f <= GROUND_Y) {
+            if (sweepFallingBlock(groundBody, deltaTime)) {
                 currentBlock->y = GROUND_Y + currentBlock->height / 2.0f;
+                addImpact(currentBlock->x, GROUND_Y, currentBlock->width, fallingSpeed);
+                freezeFallingBlock();
+                long long failedFloor;
+                stability.addBlock(currentBlock->x, currentBlock->width, failedFloor);
                 placedBlocks.push_back(*currentBlock);
+                sway.addFloor(0.0f);
                 score++;
                 spawnNewBlock();
             }
@@ -421,83 +915,135 @@ void Game::update(float deltaTime) {
             Block& topBlock = placedBlocks.back();
             float targetY = topBlock.y + topBlock.height / 2.0f + currentBlock->height / 2.0f;
 
-            if (currentBlock->y <= targetY) {
-                currentBlock->y = targetY;
-
+            // Udar u vrh u ovom koraku ili promasaj (blok je vec prosao vrh, a ne preklapa ga). Blok
+            // koji se ne postavi ostaje kruto telo i pada dalje od trenutka udara.
+            if (sweepFallingBlock(towerBodies.back(), deltaTime) || currentBlock->y <= targetY) {
                 if (currentBlock->overlaps(topBlock)) {
+                    addImpact(currentBlock->x, targetY - currentBlock->height / 2.0f, currentBlock->width, fallingSpeed);
                     float overhang = currentBlock->getTotalOverhang(topBlock);
                     float maxOverhang = currentBlock->width * OVERHANG_LIMIT;
+                    float spanLeft, spanRight;
+                    supportedSpan(topBlock, spanLeft, spanRight);
 
+                    long long failedFloor = -1;
                     if (overhang > maxOverhang) {
-                        std::cout << "\n========================================" << std::endl;
-                        std::cout << "?? GAME OVER - Blok previše viri!" << std::endl;
-                        std::cout << "   Overhang: " << overhang << " (Max: " << maxOverhang << ")" << std::endl;
-                        std::cout << "   Score: " << score << std::endl;
-                        std::cout << "========================================\n" << std::endl;
+                        LOG_INFO("GAME OVER - blok previse viri: overhang %.3f (max %.3f), score %d", overhang, maxOverhang, score);
                         state = GAME_OVER;
+                        endRun();
+                    }
+                    else if (!stability.addBlock((spanLeft + spanRight) / 2.0f, spanRight - spanLeft, failedFloor)) {
+                        // Svaki blok je dovoljno na donjem, ali teziste gornjeg dela je preslo ivicu sprata
+                        LOG_INFO("GAME OVER - zgrada se srusila: teziste iznad sprata %lld van oslonca, score %d", failedFloor, score);
+                        state = GAME_OVER;
+                        endRun();
                     }
                     else {
+                        // Udar van centra gura vrh na tu stranu; odnosi su prema sirini pre odlamanja
+                        float overhangRatio = overhang / currentBlock->width;
+                        float missRatio = (currentBlock->x - topBlock.x) / currentBlock->width;
+                        currentBlock->y = targetY;
+                        breakOffOverhang(topBlock);
+                        freezeFallingBlock();
                         placedBlocks.push_back(*currentBlock);
+                        sway.addFloor(overhangRatio);
+                        sway.kickTop(missRatio * SWAY_KICK);
                         score++;
-                        std::cout << "? Blok uspešno postavljen! Score: " << score << std::endl;
-
-                        if (overhang > 0.01f) {
-                            float errorRatio = overhang / maxOverhang;
-                            buildingSwayAmplitude += errorRatio * 0.05f;
-                            buildingSwaySpeed = 2.0f + buildingSwayAmplitude * 3.0f;
-                        }
+                        runOverhangSum += overhangRatio;
+                        runOverhangCount++;
+                        LOG_DEBUG("Blok postavljen, score %d", score);
 
                         spawnNewBlock();
                     }
                 }
                 else {
-                    std::cout << "\n========================================" << std::endl;
-                    std::cout << "?? GAME OVER - Potpuni promašaj!" << std::endl;
-                    std::cout << "   Blokovi se ne preklapaju" << std::endl;
-                    std::cout << "   Current block X: " << currentBlock->x << std::endl;
-                    std::cout << "   Top block X: " << topBlock.x << std::endl;
-                    std::cout << "   Score: " << score << std::endl;
-                    std::cout << "========================================\n" << std::endl;
+                    LOG_INFO("GAME OVER - promasaj: blok x %.3f, vrh x %.3f, score %d", currentBlock->x, topBlock.x, score);
                     state = GAME_OVER;
+                    endRun();
                 }
             }
         }
     }
 
-    if (buildingSwayAmplitude > 0.0f) {
-        buildingSwayAngle += buildingSwaySpeed * deltaTime;
-    }
+    stepPhysics(deltaTime);
+    sway.step(deltaTime);
 }
 
-void Game::dropBlock() {
+// Klik je stigao izmedju dva koraka, a ekran (interpolacija) kasni jedan korak za simulacijom.
+// Klatno se zato prvo vrati/pomeri na stanje koje je igrac video u trenutku klika, pa tek onda
+// blok pada - preciznost zavisi od vremena dogadjaja, ne od broja frejmova. Kamera se za tih
+// nekoliko milisekundi ne pomera.
+void Game::dropBlock(int stepOffsetUs) {
     if (state == GAME_OVER) {
-        std::cout << "?? dropBlock(): Ne mogu dropovati blok - GAME_OVER!" << std::endl;
+        LOG_DEBUG("dropBlock(): GAME_OVER - blok se ne pusta");
         return;
     }
     if (blockFalling) {
-        std::cout << "?? dropBlock(): Blok ve? pada!" << std::endl;
+        LOG_DEBUG("dropBlock(): blok vec pada");
         return;
     }
 
-    std::cout << "?? dropBlock(): Pustem blok!" << std::endl;
+    float shift = stepOffsetUs / 1000000.0f - static_cast<float>(1.0 / SIMULATION_RATE);
+    if (shift > MAX_DROP_SHIFT) shift = MAX_DROP_SHIFT;
+    if (shift < -MAX_DROP_SHIFT) shift = -MAX_DROP_SHIFT;
+    int subSteps = static_cast<int>(ceil(fabs(shift) / DROP_SUB_STEP));
+    for (int i = 0; i < subSteps; i++) {
+        advanceSwing(shift / subSteps);
+    }
+
+    LOG_DEBUG("dropBlock(): blok pusten (pomeraj klatna %.2f ms)", shift * 1000.0f);
     blockFalling = true;
+    fallingBody = physics.createBody(Vec2(currentBlock->x, currentBlock->y),
+        Vec2(currentBlock->width / 2.0f, currentBlock->height / 2.0f), 1.0f);
+    physics.body(fallingBody).velocity = Vec2(0.0f, -fallSpeed);
+    fallingTouching = false;
+    runDrops++;
+}
+
+void Game::endRun() {
+    runEndTime = glfwGetTime();
+}
+
+// Partija ide u istoriju jednom: sa imenom kada ga igrac unese, inace bez imena pri restartu/izlazu
+void Game::recordRun(const std::string& name) {
+    runRecorded = true;
+    if (replayingInput) return;
+
+    RunRecord run;
+    size_t nameLength = name.copy(run.name, ScoreRecord::MAX_NAME_LENGTH);
+    run.name[nameLength] = '\0';
+    run.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    run.score = score;
+    run.durationMs = static_cast<int>((runEndTime - runStartTime) * 1000.0);
+    run.drops = runDrops;
+    run.meanOverhang = runOverhangCount > 0 ? runOverhangSum / runOverhangCount : 0.0f;
+    run.finalSwayAmplitude = sway.getPeakTopOffset();
+
+    scorePersistence.submitRun(run);
 }
 
 // restart - Restartuje igru
 void Game::restart() {
-    std::cout << "\n?? RESTARTOVANJE IGRE..." << std::endl;
+
+    if (state == GAME_OVER && !runRecorded) recordRun("");
 
     state = PLAYING;
     score = 0;
+    runStartTime = glfwGetTime();
+    runDrops = 0;
+    runOverhangSum = 0.0f;
+    runOverhangCount = 0;
+    runRecorded = false;
 
     placedBlocks.clear();
+    stability.reset();
+    resetPhysics();
 
     cameraY = 0.0f;
     targetCameraY = 0.0f;
 
-    buildingSwayAngle = 0.0f;
-    buildingSwaySpeed = 0.0f;
-    buildingSwayAmplitude = 0.0f;
+    sway.reset();
+    towerGeneration++;
 
     if (currentBlock) {
         delete currentBlock;
@@ -508,9 +1054,13 @@ void Game::restart() {
     swingAngle = 0.0f;
     swingSpeed = 2.0f;
 
+    // Sledeca pozadina (placeholder dok se ne ucita); teksture menja render kada vidi snapshot
+    backgroundIndex = (backgroundIndex + 1) % BACKGROUND_COUNT;
+    motionReset = true;
+
     spawnNewBlock();
 
-    std::cout << "? Igra restartovana! Score: 0" << std::endl;
+    LOG_INFO("Igra restartovana");
 }
 
 void Game::drawBlock(const Block& block, float offsetX, float rotation) {
@@ -526,7 +1076,7 @@ void Game::drawBlock(const Block& block, float offsetX, float rotation) {
         block.width * cosR, block.width * sinR, 0.0f, 0.0f,
         -block.height * sinR, block.height * cosR, 0.0f, 0.0f,
         0.0f, 0.0f, 1.0f, 0.0f,
-        block.x + offsetX, block.y - cameraY, 0.0f, 1.0f
+        block.x + offsetX, block.y - renderCameraY, 0.0f, 1.0f
     };
 
     GLuint modelLoc = glGetUniformLocation(shaderProgram, "uModel");
@@ -562,6 +1112,142 @@ void Game::drawBlock(const Block& block, float offsetX, float rotation) {
     }
 }
 
+// Sve cestice jednim instanciranim pozivom: kvad bloka, a pozicija/velicina/providnost po instanci
+void Game::drawDust() {
+    if (dust.getCount() == 0) return;
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glUseProgram(shaderProgram);
+
+    GLuint projLoc = glGetUniformLocation(shaderProgram, "uProjection");
+    glUniformMatrix4fv(projLoc, 1, GL_FALSE, projectionMatrix);
+
+    float model[16] = {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, -renderCameraY, 0.0f, 1.0f
+    };
+    GLuint modelLoc = glGetUniformLocation(shaderProgram, "uModel");
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, model);
+
+    GLuint useTexLoc = glGetUniformLocation(shaderProgram, "uUseTexture");
+    glUniform1i(useTexLoc, 0);
+    GLuint colorLoc = glGetUniformLocation(shaderProgram, "uColor");
+    glUniform4f(colorLoc, 0.78f, 0.72f, 0.62f, 0.7f);
+    GLuint instancedLoc = glGetUniformLocation(shaderProgram, "uInstanced");
+    glUniform1i(instancedLoc, 1);
+
+    // Stari sadrzaj bafera se napusta - drajver ne ceka da GPU zavrsi prethodni frejm
+    size_t bytes = dust.getCount() * ParticleSystem::INSTANCE_FLOATS * sizeof(float);
+    glBindBuffer(GL_ARRAY_BUFFER, particleVBO);
+    glBufferData(GL_ARRAY_BUFFER, dust.getCapacity() * ParticleSystem::INSTANCE_FLOATS * sizeof(float), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, dust.getInstances());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindVertexArray(particleVAO);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(dust.getCount()));
+    glBindVertexArray(0);
+
+    glUniform1i(instancedLoc, 0);
+    glDisable(GL_BLEND);
+}
+
+// Svi spratovi jednim instanciranim pozivom. U istoj generaciji zgrade spratovi se samo dodaju,
+// pa se salju samo novi; pomeraji njihanja idu svaki frejm, ali samo za vidljive spratove na vrhu.
+void Game::drawTower(const GameSnapshot& view, float alpha) {
+    size_t floors = view.tower.size();
+    if (floors == 0) return;
+
+    if (view.towerGeneration != uploadedGeneration || floors < uploadedFloors) {
+        uploadedGeneration = view.towerGeneration;
+        uploadedFloors = 0;
+        uploadedSwayFirst = 0;
+    }
+    if (floors > towerCapacity) {
+        towerCapacity = std::max(floors, std::max(towerCapacity * 2, static_cast<size_t>(64)));
+        glBindBuffer(GL_ARRAY_BUFFER, towerInstanceVBO);
+        glBufferData(GL_ARRAY_BUFFER, towerCapacity * TOWER_INSTANCE_FLOATS * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+        towerOffsets.assign(towerCapacity, 0.0f);
+        glBindBuffer(GL_ARRAY_BUFFER, towerOffsetVBO);
+        glBufferData(GL_ARRAY_BUFFER, towerCapacity * sizeof(float), towerOffsets.data(), GL_DYNAMIC_DRAW);
+        uploadedFloors = 0;
+        uploadedSwayFirst = 0;
+    }
+    if (floors > uploadedFloors) {
+        // Sa teksturom boja samo propusta teksturu (kao drawBlock)
+        towerInstanceData.resize((floors - uploadedFloors) * TOWER_INSTANCE_FLOATS);
+        for (size_t i = uploadedFloors; i < floors; i++) {
+            const Block& block = view.tower[i];
+            float* out = &towerInstanceData[(i - uploadedFloors) * TOWER_INSTANCE_FLOATS];
+            out[0] = block.x;
+            out[1] = block.y;
+            out[2] = block.width;
+            out[3] = block.height;
+            out[4] = blockTexture != 0 ? 1.0f : block.r;
+            out[5] = blockTexture != 0 ? 1.0f : block.g;
+            out[6] = blockTexture != 0 ? 1.0f : block.b;
+            out[7] = 1.0f;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, towerInstanceVBO);
+        glBufferSubData(GL_ARRAY_BUFFER, uploadedFloors * TOWER_INSTANCE_FLOATS * sizeof(float),
+            towerInstanceData.size() * sizeof(float), towerInstanceData.data());
+        uploadedFloors = floors;
+    }
+
+    // Snapshot je stanje na kraju koraka, a frejm prikazuje trenutak alpha izmedju dva koraka
+    float lag = (1.0f - alpha) * static_cast<float>(1.0 / SIMULATION_RATE);
+    size_t first = std::min(view.swayFirstFloor, floors);
+    size_t swayed = std::min(floors - first, view.swayOffsets.size());
+    glBindBuffer(GL_ARRAY_BUFFER, towerOffsetVBO);
+    if (first > uploadedSwayFirst) {
+        // Spratovi koji su izasli iz prozora ostaju bez njihanja (ispod ekrana su)
+        towerOffsets.assign(first - uploadedSwayFirst, 0.0f);
+        glBufferSubData(GL_ARRAY_BUFFER, uploadedSwayFirst * sizeof(float), towerOffsets.size() * sizeof(float), towerOffsets.data());
+    }
+    uploadedSwayFirst = first;
+    towerOffsets.resize(swayed);
+    for (size_t i = 0; i < swayed; i++) {
+        towerOffsets[i] = view.swayOffsets[i] - view.swayVelocities[i] * lag;
+    }
+    if (swayed > 0) {
+        glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(float), swayed * sizeof(float), towerOffsets.data());
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glUseProgram(shaderProgram);
+    GLuint projLoc = glGetUniformLocation(shaderProgram, "uProjection");
+    glUniformMatrix4fv(projLoc, 1, GL_FALSE, projectionMatrix);
+    float model[16] = {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, -renderCameraY, 0.0f, 1.0f
+    };
+    GLuint modelLoc = glGetUniformLocation(shaderProgram, "uModel");
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, model);
+
+    GLuint useTexLoc = glGetUniformLocation(shaderProgram, "uUseTexture");
+    glUniform1i(useTexLoc, blockTexture != 0 ? 1 : 0);
+    if (blockTexture != 0) {
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, blockTexture);
+        GLuint texLoc = glGetUniformLocation(shaderProgram, "uTexture");
+        glUniform1i(texLoc, 0);
+    }
+    GLuint colorLoc = glGetUniformLocation(shaderProgram, "uColor");
+    glUniform4f(colorLoc, 1.0f, 1.0f, 1.0f, 1.0f);
+    GLuint instancedLoc = glGetUniformLocation(shaderProgram, "uInstanced");
+    glUniform1i(instancedLoc, 2);
+
+    glBindVertexArray(towerVAO);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(floors));
+    glBindVertexArray(0);
+
+    glUniform1i(instancedLoc, 0);
+}
+
 void Game::drawRope(float x1, float y1, float x2, float y2) {
     glUseProgram(shaderProgram);
 
@@ -574,7 +1260,7 @@ void Game::drawRope(float x1, float y1, float x2, float y2) {
 
     float angle = atan2(dx, -dy);
 
-    float ropeWidth = 0.03f;
+    float ropeWidth = ROPE_WIDTH;
 
     float centerX = (x1 + x2) / 2.0f;
     float centerY = (y1 + y2) / 2.0f;
@@ -652,6 +1338,45 @@ void Game::drawHook(float x, float y) {
     glBindVertexArray(0);
 }
 
+// Dekoracija stoji na zemlji, x je centar u world space
+void Game::drawDecoration(unsigned int texture, float x, float width, float height) {
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glUseProgram(shaderProgram);
+
+    GLuint projLoc = glGetUniformLocation(shaderProgram, "uProjection");
+    glUniformMatrix4fv(projLoc, 1, GL_FALSE, projectionMatrix);
+
+    float model[16] = {
+        width, 0.0f, 0.0f, 0.0f,
+        0.0f, height, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        x, GROUND_Y + height / 2.0f - renderCameraY, 0.0f, 1.0f
+    };
+
+    GLuint modelLoc = glGetUniformLocation(shaderProgram, "uModel");
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, model);
+
+    GLuint useTexLoc = glGetUniformLocation(shaderProgram, "uUseTexture");
+    glUniform1i(useTexLoc, 1);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    GLuint texLoc = glGetUniformLocation(shaderProgram, "uTexture");
+    glUniform1i(texLoc, 0);
+
+    GLuint colorLoc = glGetUniformLocation(shaderProgram, "uColor");
+    glUniform4f(colorLoc, 1.0f, 1.0f, 1.0f, 1.0f);
+
+    glBindVertexArray(blockVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glBindVertexArray(0);
+
+    glDisable(GL_BLEND);
+}
+
 void Game::drawText(const char* text, float x, float y, float scale) {
     glUseProgram(shaderProgram);
 
@@ -705,38 +1430,12 @@ void Game::onKeyPressed(int key) {
         if (key == GLFW_KEY_ENTER || key == GLFW_KEY_KP_ENTER) {
             enteringName = false;
 
-            if (!playerName.empty()) {
-                std::cout << "Ime sacuvano: " << playerName << std::endl;
-                std::string filename = "PlayersScore.csv";
-                std::ifstream infile(filename);
-                std::vector<std::pair<std::string, int>> scores;
-                bool found = false;
-                if (infile.is_open()) {
-                    std::string line;
-                    while (std::getline(infile, line)) {
-                        std::stringstream ss(line);
-                        std::string name;
-                        int scoreValue;
-                        if (std::getline(ss, name, ',') && ss >> scoreValue) {
-                            if (name == playerName) {
-                                scoreValue = score;
-                                found = true;
-                            }
-                            scores.push_back({ name, scoreValue });
-                        }
-                    }
-                    infile.close();
-                }
-
-                if (!found) {
-                    scores.push_back({ playerName, score });
-                }
-
-                std::ofstream outfile(filename, std::ios::trunc);
-                for (const auto& entry : scores) {
-                    outfile << entry.first << "," << entry.second << "\n";
-                }
-                outfile.close();
+            if (!playerName.empty() && !replayingInput) {
+                LOG_INFO("Ime sacuvano: %s (score %d)", playerName.c_str(), score);
+                leaderboard.submit(playerName, score);
+                scorePersistence.submit(playerName, score);
+                if (!runRecorded) recordRun(playerName);
+                if (leaderboardClient) leaderboardClient->submit(playerName, score);
             }
             return;
         }
@@ -752,7 +1451,92 @@ void Game::onCharEntered(unsigned int codepoint) {
     }
 }
 
+bool Game::needsRedraw() {
+    if (snapshots.hasFresh() || texturesPending || dust.getCount() > 0) return true;
+    if (glfwGetTime() - lastCursorBlink > CURSOR_BLINK_INTERVAL) return true;
+
+    // Sledeca pozadina se dekodira u pozadini - upload i bez crtanja
+    textureManager->update();
+    return leaderboardClient && leaderboardClient->pollTopScores(remoteTopScores, remoteTopVersion);
+}
+
+double Game::getIdleTimeout() const {
+    double untilBlink = CURSOR_BLINK_INTERVAL - (glfwGetTime() - lastCursorBlink);
+    return untilBlink > 0.001 ? untilBlink : 0.001;
+}
+
+bool Game::takeShownInput(InputTiming& timing) {
+    if (!newInputShown) return false;
+    newInputShown = false;
+    timing = snapshots.front().inputTiming;
+    return true;
+}
+
 void Game::render() {
+    // Najnovije stanje simulacije; ako novog nema, crta se prethodno
+    snapshots.acquire();
+    const GameSnapshot& view = snapshots.front();
+
+    // Izmedju prethodnog i poslednjeg koraka, prema vremenu proteklom od poslednjeg (ostatak
+    // akumulatora). Slika kasni najvise jedan korak, ali je kretanje glatko na bilo kom osvezavanju.
+    float alpha = static_cast<float>((glfwGetTime() - view.stepTime) * SIMULATION_RATE);
+    if (alpha < 0.0f) alpha = 0.0f;
+    if (alpha > 1.0f) alpha = 1.0f;
+    const MotionState& from = view.previousMotion;
+    const MotionState& to = view.motion;
+    renderCameraY = from.cameraY + (to.cameraY - from.cameraY) * alpha;
+    if (view.inputSequence != shownInputSequence) {
+        shownInputSequence = view.inputSequence;
+        newInputShown = true;
+    }
+    Block movingBlock = view.currentBlock;
+    float movingAngle = 0.0f;
+    if (!view.blockFalling) {
+        // Blok na uzetu ide po luku - interpolira se ugao, ne pozicija
+        float swingAngle = from.swingAngle + (to.swingAngle - from.swingAngle) * alpha;
+        movingBlock.x = ROPE_LENGTH * sin(swingAngle);
+        movingBlock.y = HOOK_Y + renderCameraY - ROPE_LENGTH * cos(swingAngle);
+    }
+    else {
+        movingBlock.x = from.blockX + (to.blockX - from.blockX) * alpha;
+        movingBlock.y = from.blockY + (to.blockY - from.blockY) * alpha;
+        movingAngle = from.blockAngle + (to.blockAngle - from.blockAngle) * alpha;
+    }
+
+    // Restart na niti simulacije menja pozadinu - TextureManager se koristi samo sa ove niti
+    if (view.backgroundIndex != pinnedBackground) {
+        textureManager->setPinned(backgroundHandles[pinnedBackground], false);
+        pinnedBackground = view.backgroundIndex;
+        textureManager->setPinned(backgroundHandles[pinnedBackground], true);
+    }
+
+    if (view.state == GAME_OVER) {
+        // Igrac je na ekranu kraja igre - vreme za ucitavanje sledece pozadine
+        textureManager->prefetch(backgroundHandles[(pinnedBackground + 1) % BACKGROUND_COUNT]);
+
+        double now = glfwGetTime();
+        if (now - lastCursorBlink > CURSOR_BLINK_INTERVAL) {
+            cursorVisible = !cursorVisible;
+            lastCursorBlink = now;
+        }
+    }
+
+    // Prasina iz udara koje ovaj frejm prvi vidi (starije od IMPACT_HISTORY su propustene)
+    unsigned long long firstImpact = view.impactSequence > GameSnapshot::IMPACT_HISTORY ? view.impactSequence - GameSnapshot::IMPACT_HISTORY : 0;
+    for (unsigned long long n = std::max(emittedImpacts, firstImpact); n < view.impactSequence; n++) {
+        const ImpactEvent& impact = view.impacts[n % GameSnapshot::IMPACT_HISTORY];
+        dust.emitDust(impact.x, impact.y, impact.width, static_cast<int>(impact.strength * DUST_PER_SPEED), impact.strength);
+    }
+    emittedImpacts = view.impactSequence;
+    double dustTime = glfwGetTime();
+    float dustStep = lastDustTime > 0.0 ? static_cast<float>(std::min(dustTime - lastDustTime, 0.1)) : 0.0f;
+    lastDustTime = dustTime;
+    dust.update(dustStep);
+
+    // Upload tekstura koje je pozadinska nit dekodirala
+    textureManager->update();
+    backgroundTexture = textureManager->get(backgroundHandles[pinnedBackground]);
+
     glUseProgram(shaderProgram);
 
     GLuint projLoc = glGetUniformLocation(shaderProgram, "uProjection");
@@ -796,7 +1580,7 @@ void Game::render() {
         100.0f, 0.0f, 0.0f, 0.0f,
         0.0f, groundHeight, 0.0f, 0.0f,
         0.0f, 0.0f, 1.0f, 0.0f,
-        0.0f, groundCenterY - cameraY, 0.0f, 1.0f
+        0.0f, groundCenterY - renderCameraY, 0.0f, 1.0f
     };
 
     glUniformMatrix4fv(modelLoc, 1, GL_FALSE, groundModel);
@@ -814,32 +1598,43 @@ void Game::render() {
     glDrawArrays(GL_TRIANGLES, 0, 6);
     glBindVertexArray(0);
 
+    drawDecoration(textureManager->get(treeHandle), -aspectRatio * 0.75f, TREE_WIDTH, TREE_HEIGHT);
+    drawDecoration(textureManager->get(benchHandle), -aspectRatio * 0.4f, BENCH_WIDTH, BENCH_HEIGHT);
+    drawDecoration(textureManager->get(castleHandle), aspectRatio * 0.6f, CASTLE_WIDTH, CASTLE_HEIGHT);
+    texturesPending = !textureManager->isResident(backgroundHandles[pinnedBackground]) || !textureManager->isResident(treeHandle)
+        || !textureManager->isResident(benchHandle) || !textureManager->isResident(castleHandle);
+    textureManager->endFrame();
+
+    glUseProgram(shaderProgram);
+    glUniformMatrix4fv(projLoc, 1, GL_FALSE, projectionMatrix);
     glUniform1i(useTexLoc, 0);
 
-    float swayOffset = 0.0f;
-    if (buildingSwayAmplitude > 0.0f) {
-        swayOffset = sin(buildingSwayAngle) * buildingSwayAmplitude;
-    }
+    drawTower(view, alpha);
 
-    for (const auto& block : placedBlocks) {
-        drawBlock(block, swayOffset);
+    for (const auto& piece : view.debris) {
+        Block block = piece.block;
+        block.x = piece.previousX + (piece.block.x - piece.previousX) * alpha;
+        block.y = piece.previousY + (piece.block.y - piece.previousY) * alpha;
+        drawBlock(block, 0.0f, piece.previousAngle + (piece.angle - piece.previousAngle) * alpha);
     }
 
-    if (currentBlock) {
-        if (!blockFalling) {
+    if (view.hasCurrentBlock) {
+        if (!view.blockFalling) {
             float hookX = 0.0f;
             float hookY = HOOK_Y;
             drawHook(hookX, hookY);
 
-            float blockTopX = currentBlock->x;
-            float blockTopY = currentBlock->y + currentBlock->height / 2.0f;
+            float blockTopX = movingBlock.x;
+            float blockTopY = movingBlock.y + movingBlock.height / 2.0f;
 
-            drawRope(hookX, hookY, blockTopX, blockTopY - cameraY);
+            drawRope(hookX, hookY, blockTopX, blockTopY - renderCameraY);
         }
 
-        drawBlock(*currentBlock);
+        drawBlock(movingBlock, 0.0f, movingAngle);
     }
 
+    drawDust();
+
     if (textRenderer) {
         std::string controlsText = "ESC - Exit  |  CTRL + R - Restart  |  ENTER or LEFT MOUSE CLICK - Drop Block";
         float controlsWidth = textRenderer->getTextWidth(controlsText, 0.5f);
@@ -847,7 +1642,7 @@ void Game::render() {
         textRenderer->renderText(controlsText, controlsX, 50.0f, 0.5f, 0.9f, 0.9f, 0.9f);
 
         std::ostringstream scoreStream;
-        scoreStream << "Score: " << score;
+        scoreStream << "Score: " << view.score;
         std::string scoreText = scoreStream.str();
         float scoreWidth = textRenderer->getTextWidth(scoreText, 1.0f);
         float scoreX = windowWidth - scoreWidth - 20.0f;
@@ -961,62 +1756,37 @@ void Game::render() {
 
         glUniformMatrix4fv(projLoc, 1, GL_FALSE, projectionMatrix);
 
-        std::vector<std::pair<std::string, int>> topScores;
-        std::ifstream file("PlayersScore.csv");
-        if (!file.is_open()) {
-            std::cerr << "Ne mogu da otvorim fajl: " << "PlayersScore.csv" << std::endl;
-        }
-
-        std::string line;
-        while (std::getline(file, line)) {
-            std::stringstream ss(line);
-            std::string playerName;
-            std::string scoreStr;
-
-            if (std::getline(ss, playerName, ',') && std::getline(ss, scoreStr)) {
-                int score = std::stoi(scoreStr);
-                topScores.emplace_back(playerName, score);
-            }
-        }
-        file.close();
-
-        std::sort(topScores.begin(), topScores.end(),
-            [](const auto& a, const auto& b) { return a.second > b.second; });
-
-        if (topScores.size() > 3) {
-            topScores.resize(3);
-        }
-
-        std::pair<std::string, int> temp = topScores[0];
-        topScores[0] = topScores[2];
-        topScores[2] = temp;
+        // Lista sa servera (ako je ima); poll ne blokira, pa render nikad ne ceka mrezu
+        if (leaderboardClient) leaderboardClient->pollTopScores(remoteTopScores, remoteTopVersion);
+        const TopScores& topScores = remoteTopVersion > 0 ? remoteTopScores : view.topScores;
 
         float fontSize = 0.7f;
         float startX = 20.0f; 
         float startY = 20.0f;   
         float lineSpacing = 40.0f; 
 
-        for (int i = 0; i < topScores.size(); ++i) {
-            std::string text = topScores[i].first + " " + std::to_string(topScores[i].second);
+        // Najbolji rezultat je uvek u gornjoj liniji, i kada ih ima manje od tri
+        for (int rank = 0; rank < topScores.count; ++rank) {
+            int i = TopScores::MAX_ENTRIES - 1 - rank;
             float y = startY + i * lineSpacing;
 
             float r, g, b;
-            if (i == 2) {
+            if (rank == 0) {
                 r = 1.0f; g = 0.84f; b = 0.0f;       // zlato
             }
-            else if (i == 1) {
+            else if (rank == 1) {
                 r = 0.75f; g = 0.75f; b = 0.75f;    // srebro
             }
             else {
                 r = 0.8f; g = 0.5f; b = 0.2f;       // bronza
             }
 
-            textRenderer->renderText(text, startX, windowHeight - y, fontSize, r, g, b);
+            textRenderer->renderText(topScores.lines[rank], startX, windowHeight - y, fontSize, r, g, b);
         }
     }
 
 
-    if (state == GAME_OVER) {
+    if (view.state == GAME_OVER) {
 
         if (textRenderer) {
             glEnable(GL_BLEND);
@@ -1077,9 +1847,9 @@ void Game::render() {
 
             textRenderer->renderText(nameText, nameX, nameY, 0.6f, 1.0f, 0.0f, 0.0f);
 
-            if (state == GAME_OVER && enteringName) {
+            if (view.enteringName) {
 
-                std::string display = playerName;
+                const std::string& display = view.playerName;
                 float w = textRenderer->getTextWidth(display, 1.2f);
                 float x = (windowWidth - w) / 2.0f;
                 float y = nameY + 70.0f;
@@ -1087,13 +1857,13 @@ void Game::render() {
                 textRenderer->renderText(display, x, y, 1.2f, 1.0f, 1.0f, 1.0f);
 
                 if (cursorVisible) {
-                    float width = textRenderer->getTextWidth(playerName, 1.2f);
+                    float width = textRenderer->getTextWidth(view.playerName, 1.2f);
                     textRenderer->renderText("|", x + width, y, 1.2f, 1.0f, 1.0f, 1.0f);
                 }
             }
 
             std::ostringstream scoreSt;
-            scoreSt << "Your score: " << score;
+            scoreSt << "Your score: " << view.score;
             std::string scoreText = scoreSt.str();
             float scoreWidth = textRenderer->getTextWidth(scoreText, 1.0f);
             float scoreX = (windowWidth - scoreWidth) / 2.0f;
@@ -1110,11 +1880,11 @@ void Game::render() {
 
         }
         else {
-            std::cout << "   ? ERROR: textRenderer je nullptr!" << std::endl;
+            LOG_ERROR("textRenderer je nullptr");
         }
     }
 
-    for (int i = 0; i < score && i < 20; i++) {
+    for (int i = 0; i < view.score && i < 20; i++) {
         float model[16] = {
             0.02f, 0.0f, 0.0f, 0.0f,
             0.0f, 0.02f, 0.0f, 0.0f,
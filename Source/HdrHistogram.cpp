@@ -0,0 +1,76 @@
+#include "../Header/HdrHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static int highestBit(unsigned long long value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+
+// [0, 2 * SUB_BUCKET_COUNT) linearno, pa SUB_BUCKET_COUNT korpi po oktavi
+int HdrHistogram::bucketIndex(long long value) {
+    if (value < 2 * SUB_BUCKET_COUNT) return static_cast<int>(value);
+
+    int shift = highestBit(static_cast<unsigned long long>(value)) - SUB_BUCKET_BITS;
+    int sub = static_cast<int>(value >> shift);
+    return 2 * SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_COUNT + (sub - SUB_BUCKET_COUNT);
+}
+
+long long HdrHistogram::bucketHighValue(int index) {
+    if (index < 2 * SUB_BUCKET_COUNT) return index;
+
+    int offset = index - 2 * SUB_BUCKET_COUNT;
+    int shift = offset / SUB_BUCKET_COUNT + 1;
+    long long sub = offset % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+    return ((sub + 1) << shift) - 1;
+}
+
+HdrHistogram::HdrHistogram(long long highest)
+    : counts(bucketIndex(highest) + 1, 0), highestTrackable(highest), total(0), maxValue(0)
+{
+}
+
+void HdrHistogram::record(long long value) {
+    if (value < 0) value = 0;
+    if (value > highestTrackable) value = highestTrackable;
+
+    counts[bucketIndex(value)]++;
+    total++;
+    if (value > maxValue) maxValue = value;
+}
+
+void HdrHistogram::add(const HdrHistogram& other) {
+    size_t count = std::min(counts.size(), other.counts.size());
+    for (size_t i = 0; i < count; i++) {
+        counts[i] += other.counts[i];
+    }
+    total += other.total;
+    maxValue = std::max(maxValue, other.maxValue);
+}
+
+void HdrHistogram::reset() {
+    std::fill(counts.begin(), counts.end(), 0);
+    total = 0;
+    maxValue = 0;
+}
+
+long long HdrHistogram::percentile(double fraction) const {
+    if (total == 0) return 0;
+
+    long long target = std::max(1LL, static_cast<long long>(std::ceil(fraction * total)));
+    long long seen = 0;
+    for (size_t i = 0; i < counts.size(); i++) {
+        seen += counts[i];
+        if (seen >= target) return std::min(bucketHighValue(static_cast<int>(i)), maxValue);
+    }
+    return maxValue;
+}
@@ -0,0 +1,91 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../Header/InputLog.h"
+#include <cstring>
+#include <iostream>
+
+// Isti redosled kao InputEvent::Type
+static const char* TYPE_NAMES[] = { "DROP", "RESTART", "KEY", "CHAR" };
+static const int TYPE_COUNT = sizeof(TYPE_NAMES) / sizeof(TYPE_NAMES[0]);
+
+InputLog::~InputLog() {
+    close();
+}
+
+bool InputLog::openRecord(const std::string& path, unsigned int seed) {
+    close();
+    file = fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Ne mogu da napravim zapis ulaza: " << path << std::endl;
+        return false;
+    }
+    fprintf(file, "seed,%u\nstep,type,key,codepoint,offsetUs\n", seed);
+    return true;
+}
+
+// Dogadjaji su retki - fprintf ide u bafer, na disk pri zatvaranju
+void InputLog::record(long long step, const InputEvent& event) {
+    if (!file) return;
+    fprintf(file, "%lld,%s,%d,%u,%d\n", step, TYPE_NAMES[event.type], event.key, event.codepoint, event.stepOffsetUs);
+}
+
+bool InputLog::load(const std::string& path, unsigned int& seed) {
+    close();
+    FILE* input = fopen(path.c_str(), "rb");
+    if (!input) {
+        std::cerr << "Ne mogu da otvorim zapis ulaza: " << path << std::endl;
+        return false;
+    }
+
+    char line[128];
+    if (!fgets(line, sizeof(line), input) || sscanf(line, "seed,%u", &seed) != 1) {
+        std::cerr << "Neispravan zapis ulaza (nema semena): " << path << std::endl;
+        fclose(input);
+        return false;
+    }
+
+    long long skipped = 0;
+    while (fgets(line, sizeof(line), input)) {
+        Entry entry;
+        char typeName[16];
+        // Zapisi bez kolone offsetUs (stariji format) pustaju blok na pocetku koraka
+        entry.event.stepOffsetUs = 0;
+        if (sscanf(line, "%lld,%15[^,],%d,%u,%d", &entry.step, typeName, &entry.event.key, &entry.event.codepoint,
+                &entry.event.stepOffsetUs) < 4) {
+            if (strncmp(line, "step,", 5) != 0) skipped++;
+            continue;
+        }
+
+        int type = 0;
+        while (type < TYPE_COUNT && strcmp(typeName, TYPE_NAMES[type]) != 0) type++;
+        // Koraci moraju da rastu - inace bi dogadjaj ostao zauvek u redu
+        if (type == TYPE_COUNT || entry.step < 0 || (!entries.empty() && entry.step < entries.back().step)) {
+            skipped++;
+            continue;
+        }
+        entry.event.type = static_cast<InputEvent::Type>(type);
+        entry.event.timestamp = 0.0;
+        entries.push_back(entry);
+    }
+    fclose(input);
+
+    if (skipped > 0) {
+        std::cout << path << ": preskoceno neispravnih linija: " << skipped << std::endl;
+    }
+    std::cout << "Pustanje zapisa ulaza: " << entries.size() << " dogadjaja, seme " << seed << std::endl;
+    return true;
+}
+
+bool InputLog::nextDue(long long step, InputEvent& event) {
+    if (nextEntry >= entries.size() || entries[nextEntry].step > step) return false;
+    event = entries[nextEntry++].event;
+    return true;
+}
+
+void InputLog::close() {
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+    entries.clear();
+    nextEntry = 0;
+}
@@ -0,0 +1,60 @@
+#include "../Header/LatencyProbe.h"
+#include <cstdio>
+
+// Isti redosled kao LatencyProbe::Stage
+static const char* STAGE_NAMES[LatencyProbe::STAGE_COUNT] = { "red", "simulacija", "cekanje", "render", "swap", "gpu", "ukupno" };
+
+LatencyProbe::LatencyProbe(bool gpu)
+    : measureGpu(gpu), pending(false), renderStart(0.0), renderEnd(0.0), swapEnd(0.0)
+{
+    timing.inputTime = timing.consumedTime = timing.publishedTime = 0.0;
+}
+
+long long LatencyProbe::toMicroseconds(double seconds) {
+    // Niti citaju sat nezavisno - mala negativna razlika se racuna kao 0
+    return seconds > 0.0 ? static_cast<long long>(seconds * 1000000.0 + 0.5) : 0;
+}
+
+void LatencyProbe::frameRendered(const InputTiming& inputTiming, double start, double end) {
+    timing = inputTiming;
+    renderStart = start;
+    renderEnd = end;
+    pending = true;
+}
+
+bool LatencyProbe::swapReturned(double time) {
+    if (!pending) return false;
+    swapEnd = time;
+    if (measureGpu) return true;
+    finishSample(time);
+    return false;
+}
+
+void LatencyProbe::gpuFinished(double time) {
+    if (!pending) return;
+    histograms[STAGE_GPU].record(toMicroseconds(time - swapEnd));
+    finishSample(time);
+}
+
+void LatencyProbe::finishSample(double endTime) {
+    histograms[STAGE_QUEUE].record(toMicroseconds(timing.consumedTime - timing.inputTime));
+    histograms[STAGE_SIMULATION].record(toMicroseconds(timing.publishedTime - timing.consumedTime));
+    histograms[STAGE_WAIT_RENDER].record(toMicroseconds(renderStart - timing.publishedTime));
+    histograms[STAGE_RENDER].record(toMicroseconds(renderEnd - renderStart));
+    histograms[STAGE_SWAP].record(toMicroseconds(swapEnd - renderEnd));
+    histograms[STAGE_TOTAL].record(toMicroseconds(endTime - timing.inputTime));
+    pending = false;
+}
+
+void LatencyProbe::printReport() const {
+    printf("\n=== LATENCIJA ULAZ -> SLIKA (%lld dogadjaja) ===\n", histograms[STAGE_TOTAL].getCount());
+    printf("  %-11s %9s %9s %9s %9s\n", "faza", "p50 ms", "p95 ms", "p99 ms", "max ms");
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        const HdrHistogram& histogram = histograms[s];
+        if (histogram.getCount() == 0) continue;
+        printf("  %-11s %9.2f %9.2f %9.2f %9.2f\n", STAGE_NAMES[s],
+            histogram.percentile(0.50) / 1000.0, histogram.percentile(0.95) / 1000.0,
+            histogram.percentile(0.99) / 1000.0, histogram.getMax() / 1000.0);
+    }
+    fflush(stdout);
+}
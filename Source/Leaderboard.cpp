@@ -0,0 +1,33 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../Header/Leaderboard.h"
+#include <cstdio>
+
+void TopScores::setLine(int index, const char* name, int score) {
+    snprintf(lines[index], LINE_LENGTH, "%s %d", name, score);
+}
+
+Leaderboard::Leaderboard() {
+    topScores.count = 0;
+}
+
+void Leaderboard::load(const ScoreStore& store) {
+    index.clear();
+    store.forEach([this](const std::string& name, int score) {
+        index.set(name, score);
+    });
+    rebuildTopScores();
+}
+
+void Leaderboard::submit(const std::string& name, int score) {
+    index.set(name, score);
+    rebuildTopScores();
+}
+
+void Leaderboard::rebuildTopScores() {
+    int count = 0;
+    index.forEachTop(TopScores::MAX_ENTRIES, [this, &count](const std::string& name, int score) {
+        topScores.setLine(count, name.c_str(), score);
+        count++;
+    });
+    topScores.count = count;
+}
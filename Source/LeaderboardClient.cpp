@@ -0,0 +1,204 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../Header/LeaderboardClient.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+typedef std::chrono::steady_clock ClientClock;
+
+static const std::chrono::milliseconds WAKE_INTERVAL(50);
+static const std::chrono::milliseconds TOP_REFRESH_INTERVAL(1000);
+static const std::chrono::milliseconds MIN_RETRY_DELAY(250);
+static const std::chrono::milliseconds MAX_RETRY_DELAY(8000);
+
+LeaderboardClient::LeaderboardClient(int serverPort)
+    : port(serverPort), stopping(false), connection(INVALID_SOCKET_HANDLE), retryDelay(MIN_RETRY_DELAY), topChanged(false), topVersion(0)
+{
+    top.count = 0;
+}
+
+LeaderboardClient::~LeaderboardClient() {
+    stop();
+}
+
+void LeaderboardClient::start() {
+    if (worker.joinable()) return;
+    stopping.store(false);
+    worker = std::thread(&LeaderboardClient::workerLoop, this);
+}
+
+void LeaderboardClient::stop() {
+    if (!worker.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping.store(true);
+    }
+    wake.notify_all();
+    worker.join();
+}
+
+bool LeaderboardClient::submit(const std::string& name, int score) {
+    ScoreRecord record;
+    strncpy(record.name, name.c_str(), ScoreRecord::MAX_NAME_LENGTH);
+    record.name[ScoreRecord::MAX_NAME_LENGTH] = '\0';
+    record.score = score;
+    record.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    if (!outgoing.tryPush(record)) {
+        std::cerr << "Red za slanje rezultata je pun: " << name << std::endl;
+        return false;
+    }
+    wake.notify_one();
+    return true;
+}
+
+bool LeaderboardClient::pollTopScores(TopScores& out, uint64_t& version) {
+    std::unique_lock<std::mutex> lock(topMutex, std::try_to_lock);
+    if (!lock.owns_lock() || topVersion == version) return false;
+
+    out = top;
+    version = topVersion;
+    return true;
+}
+
+bool LeaderboardClient::ensureConnected() {
+    if (connection != INVALID_SOCKET_HANDLE) return true;
+
+    connection = netConnectLoopback(port);
+    return connection != INVALID_SOCKET_HANDLE;
+}
+
+void LeaderboardClient::disconnect() {
+    if (connection == INVALID_SOCKET_HANDLE) return;
+    netClose(connection);
+    connection = INVALID_SOCKET_HANDLE;
+}
+
+// Salje grupe dok ima nepotvrdjenih; rezultat ostaje u pending dok ne stigne ACK
+bool LeaderboardClient::sendPending() {
+    std::vector<unsigned char> request;
+    std::vector<unsigned char> response;
+
+    while (!pending.empty()) {
+        size_t count = pending.size() < static_cast<size_t>(MAX_SUBMIT_BATCH) ? pending.size() : MAX_SUBMIT_BATCH;
+
+        request.clear();
+        ByteWriter writer(request);
+        writer.u16(static_cast<uint16_t>(count));
+        for (size_t i = 0; i < count; i++) {
+            const ScoreRecord& record = pending[i];
+            writer.name(record.name, strlen(record.name));
+            writer.i32(record.score);
+            writer.i64(record.timestampMs);
+        }
+
+        uint8_t type;
+        if (!sendFrame(connection, MSG_SUBMIT_BATCH, request) || !receiveFrame(connection, type, response)) return false;
+
+        ByteReader reader(response);
+        uint32_t accepted = reader.u32();
+        uint64_t version = reader.u64();
+        if (type != MSG_SUBMIT_ACK || !reader.ok() || accepted != count) return false;
+
+        pending.erase(pending.begin(), pending.begin() + count);
+
+        // Grupa je promenila top listu - osvezava se odmah, ne tek na sledeci interval
+        std::lock_guard<std::mutex> lock(topMutex);
+        if (version != topVersion) topChanged = true;
+    }
+    return true;
+}
+
+bool LeaderboardClient::refreshTop() {
+    uint64_t knownVersion;
+    {
+        std::lock_guard<std::mutex> lock(topMutex);
+        knownVersion = topVersion;
+    }
+
+    std::vector<unsigned char> request;
+    std::vector<unsigned char> response;
+    ByteWriter writer(request);
+    writer.u64(knownVersion);
+
+    uint8_t type;
+    if (!sendFrame(connection, MSG_GET_TOP, request) || !receiveFrame(connection, type, response)) return false;
+
+    ByteReader reader(response);
+    uint64_t version = reader.u64();
+    if (type == MSG_TOP_NOT_MODIFIED) return reader.ok();
+    if (type != MSG_TOP) return false;
+
+    // Nova lista se sklapa van zakljucavanja, pa se samo kopira
+    TopScores received;
+    received.count = reader.u8();
+    if (received.count > TopScores::MAX_ENTRIES) return false;
+    for (int i = 0; i < received.count; i++) {
+        char name[ScoreRecord::MAX_NAME_LENGTH + 1];
+        if (!reader.name(name, ScoreRecord::MAX_NAME_LENGTH)) return false;
+        received.setLine(i, name, reader.i32());
+    }
+    if (!reader.ok()) return false;
+
+    std::lock_guard<std::mutex> lock(topMutex);
+    top = received;
+    topVersion = version;
+    return true;
+}
+
+void LeaderboardClient::workerLoop() {
+    ClientClock::time_point nextAttempt = ClientClock::now();
+    ClientClock::time_point nextTopRefresh = ClientClock::now();
+
+    while (true) {
+        bool stopRequested = stopping.load();
+
+        ScoreRecord record;
+        while (outgoing.tryPop(record)) {
+            pending.push_back(record);
+        }
+
+        ClientClock::time_point now = ClientClock::now();
+        bool due = !pending.empty() || now >= nextTopRefresh;
+        if (due && connection == INVALID_SOCKET_HANDLE && !stopRequested && now >= nextAttempt) {
+            if (!ensureConnected()) {
+                // Server nije dostupan - sledeci pokusaj kasnije, svaki put duplo kasnije
+                nextAttempt = now + retryDelay;
+                retryDelay = std::min(retryDelay * 2, MAX_RETRY_DELAY);
+            }
+        }
+
+        if (connection != INVALID_SOCKET_HANDLE) {
+            bool ok = sendPending();
+            if (ok && (topChanged || now >= nextTopRefresh)) {
+                topChanged = false;
+                ok = refreshTop();
+                nextTopRefresh = now + TOP_REFRESH_INTERVAL;
+            }
+
+            if (ok) {
+                retryDelay = MIN_RETRY_DELAY;
+            }
+            else {
+                disconnect();
+                nextAttempt = now + retryDelay;
+                retryDelay = std::min(retryDelay * 2, MAX_RETRY_DELAY);
+            }
+        }
+
+        if (stopRequested) break;
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait_for(lock, WAKE_INTERVAL, [this]() {
+            return stopping.load() || !outgoing.empty();
+        });
+    }
+
+    if (!pending.empty()) {
+        std::cerr << "Rezultati nisu poslati serveru: " << pending.size() << std::endl;
+    }
+    disconnect();
+}
@@ -0,0 +1,24 @@
+#include "../Header/LeaderboardProtocol.h"
+
+bool sendFrame(SocketHandle socket, uint8_t type, const std::vector<unsigned char>& payload) {
+    // Zaglavlje i telo jednim slanjem
+    std::vector<unsigned char> frame;
+    frame.reserve(5 + payload.size());
+    ByteWriter writer(frame);
+    writer.u32(static_cast<uint32_t>(payload.size()));
+    writer.u8(type);
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    return netSendAll(socket, frame.data(), frame.size());
+}
+
+bool receiveFrame(SocketHandle socket, uint8_t& type, std::vector<unsigned char>& payload) {
+    unsigned char header[5];
+    if (!netReceiveAll(socket, header, sizeof(header))) return false;
+
+    uint32_t length = header[0] | (header[1] << 8) | (header[2] << 16) | (static_cast<uint32_t>(header[3]) << 24);
+    if (length > MAX_FRAME_LENGTH) return false;
+
+    type = header[4];
+    payload.resize(length);
+    return length == 0 || netReceiveAll(socket, payload.data(), length);
+}
@@ -0,0 +1,221 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../Header/LeaderboardServer.h"
+#include "../Header/ScoreJournal.h"
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+
+static const char* SERVER_STORE_PATH = "LeaderboardServer.bin";
+static const int ACCEPT_TIMEOUT_MS = 200;
+
+static bool sameTopScores(const TopScores& a, const TopScores& b) {
+    if (a.count != b.count) return false;
+    for (int i = 0; i < a.count; i++) {
+        if (strcmp(a.lines[i], b.lines[i]) != 0) return false;
+    }
+    return true;
+}
+
+LeaderboardServer::LeaderboardServer(const std::string& storePath, FsyncPolicy fsyncPolicy, int fsyncIntervalMs)
+    : persistence(nullptr), listener(INVALID_SOCKET_HANDLE), port(0), stopping(false)
+{
+    // Verzija pocinje od vremena pokretanja, pa se ne ponavlja posle restarta servera
+    // (klijent sa starom verzijom bi inace dobijao TOP_NOT_MODIFIED za drugu listu)
+    topVersion = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+
+    if (!storePath.empty()) {
+        persistence = new ScorePersistence(storePath, "", journalPathForStore(storePath), fsyncPolicy, fsyncIntervalMs);
+        persistence->start(leaderboard);
+    }
+}
+
+LeaderboardServer::~LeaderboardServer() {
+    stop();
+    if (persistence) delete persistence;
+}
+
+bool LeaderboardServer::start(int requestedPort) {
+    listener = netListenLoopback(requestedPort, &port);
+    if (listener == INVALID_SOCKET_HANDLE) return false;
+
+    stopping.store(false);
+    acceptThread = std::thread(&LeaderboardServer::acceptLoop, this);
+    return true;
+}
+
+void LeaderboardServer::stop() {
+    if (!acceptThread.joinable()) return;
+
+    stopping.store(true);
+    acceptThread.join();
+    netClose(listener);
+    listener = INVALID_SOCKET_HANDLE;
+
+    // Prekini blokirajuca citanja klijentskih niti
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        for (SocketHandle client : clients) {
+            netShutdownSocket(client);
+        }
+    }
+    for (ClientThread& entry : clientThreads) {
+        entry.thread.join();
+    }
+    clientThreads.clear();
+
+    if (persistence) persistence->shutdown();
+}
+
+void LeaderboardServer::acceptLoop() {
+    while (!stopping.load()) {
+        reapClientThreads();
+        SocketHandle client = netAccept(listener, ACCEPT_TIMEOUT_MS);
+        if (client == INVALID_SOCKET_HANDLE) continue;
+
+        {
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            clients.push_back(client);
+        }
+        clientThreads.emplace_back();
+        ClientThread& entry = clientThreads.back();
+        entry.thread = std::thread(&LeaderboardServer::serveClient, this, client, &entry.done);
+    }
+}
+
+// Klijenti se ponovo povezuju, pa bi se niti bez spajanja gomilale dok daemon radi
+void LeaderboardServer::reapClientThreads() {
+    for (std::list<ClientThread>::iterator it = clientThreads.begin(); it != clientThreads.end();) {
+        if (it->done.load()) {
+            it->thread.join();
+            it = clientThreads.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void LeaderboardServer::serveClient(SocketHandle client, std::atomic<bool>* done) {
+    uint8_t type;
+    std::vector<unsigned char> request;
+    std::vector<unsigned char> response;
+
+    while (receiveFrame(client, type, request)) {
+        ByteReader reader(request);
+        response.clear();
+
+        uint8_t responseType;
+        if (type == MSG_SUBMIT_BATCH) {
+            if (!handleSubmit(reader, response)) break;
+            responseType = MSG_SUBMIT_ACK;
+        }
+        else if (type == MSG_GET_TOP) {
+            responseType = handleGetTop(reader, response);
+            if (!reader.ok()) break;
+        }
+        else {
+            break;   // Nepoznata poruka - prekid veze
+        }
+
+        if (!sendFrame(client, responseType, response)) break;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        clients.erase(std::remove(clients.begin(), clients.end(), client), clients.end());
+    }
+    netClose(client);
+    done->store(true);
+}
+
+bool LeaderboardServer::handleSubmit(ByteReader& reader, std::vector<unsigned char>& response) {
+    // Cela grupa se procita pre zakljucavanja; neispravna grupa se odbacuje cela
+    uint16_t count = reader.u16();
+    if (count > MAX_SUBMIT_BATCH) return false;
+
+    std::vector<ScoreRecord> batch(count);
+    for (ScoreRecord& record : batch) {
+        if (!reader.name(record.name, ScoreRecord::MAX_NAME_LENGTH)) return false;
+        record.score = reader.i32();
+        record.timestampMs = reader.i64();
+    }
+    if (!reader.ok()) return false;
+
+    // Zapis ide u red i u rang listu pod istim zakljucavanjem, pa je redosled u dnevniku isti kao u
+    // listi. Pun red = povratni pritisak: klijent ceka ACK, ali se ceka bez mutex-a, pa citaoci
+    // rang liste ne stoje.
+    std::unique_lock<std::mutex> producer(submitMutex, std::defer_lock);
+    if (persistence) producer.lock();
+    uint64_t version;
+    size_t next = 0;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            TopScores before = leaderboard.getTopScores();
+            for (; next < batch.size(); next++) {
+                if (persistence && !persistence->submit(batch[next])) break;
+                leaderboard.submit(batch[next].name, batch[next].score);
+            }
+            if (!sameTopScores(before, leaderboard.getTopScores())) topVersion++;
+            version = topVersion;
+        }
+        if (next == batch.size()) break;
+        persistence->waitForSpace();
+    }
+
+    ByteWriter writer(response);
+    writer.u32(count);
+    writer.u64(version);
+    return true;
+}
+
+uint8_t LeaderboardServer::handleGetTop(ByteReader& reader, std::vector<unsigned char>& response) {
+    uint64_t knownVersion = reader.u64();
+    ByteWriter writer(response);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    writer.u64(topVersion);
+    if (knownVersion == topVersion) return MSG_TOP_NOT_MODIFIED;
+
+    const TopScores& top = leaderboard.getTopScores();
+    writer.u8(static_cast<uint8_t>(top.count));
+    leaderboard.forEachTop(TopScores::MAX_ENTRIES, [&writer](const std::string& name, int score) {
+        writer.name(name.c_str(), name.size());
+        writer.i32(score);
+    });
+    return MSG_TOP;
+}
+
+static std::atomic<bool> daemonInterrupted(false);
+
+static void onDaemonSignal(int) {
+    daemonInterrupted.store(true);
+}
+
+int runLeaderboardDaemon(const Options& options) {
+    if (!netInit()) return -1;
+
+    int result = 0;
+    {
+        LeaderboardServer server(SERVER_STORE_PATH, options.scoreFsync, options.scoreFsyncIntervalMs);
+        if (server.start(options.leaderboardDaemonPort)) {
+            std::cout << "Rang lista slusa na 127.0.0.1:" << server.getPort() << " (Ctrl+C za kraj)" << std::endl;
+
+            signal(SIGINT, onDaemonSignal);
+            signal(SIGTERM, onDaemonSignal);
+            while (!daemonInterrupted.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(ACCEPT_TIMEOUT_MS));
+            }
+            server.stop();
+        }
+        else {
+            result = -1;
+        }
+    }
+
+    netShutdown();
+    return result;
+}
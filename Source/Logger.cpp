@@ -0,0 +1,123 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../Header/Logger.h"
+#include <algorithm>
+#include <cstdarg>
+
+// Isti redosled kao LogLevel
+static const char* LEVEL_NAMES[] = { "DEBUG", "INFO", "WARN", "ERROR" };
+
+Logger::Logger() : running(false), minLevel(LOG_LEVEL_INFO), origin(std::chrono::steady_clock::now()) {}
+
+Logger::~Logger() {
+    stop();
+    drain();     // Poruke koje su stigle u red bas dok se stop() izvrsavao
+    for (size_t i = 0; i < queues.size(); i++) {
+        delete queues[i];
+    }
+}
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+// Prva poruka niti pravi njen red (jednom, pod mutex-om); posle toga samo thread_local pokazivac
+Logger::ThreadQueue* Logger::threadQueue() {
+    static thread_local ThreadQueue* queue = nullptr;
+    if (!queue) {
+        queue = new ThreadQueue();
+        queue->dropped = 0;
+        std::lock_guard<std::mutex> lock(registryMutex);
+        queue->index = static_cast<int>(queues.size());
+        queues.push_back(queue);
+    }
+    return queue;
+}
+
+void Logger::start(LogLevel level) {
+    minLevel = level;
+    if (running) return;
+    origin = std::chrono::steady_clock::now();
+    batch.reserve(QUEUE_CAPACITY);
+    running = true;
+    flusher = std::thread(&Logger::flushLoop, this);
+}
+
+void Logger::stop() {
+    if (!running) return;
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running = false;
+    }
+    wake.notify_one();
+    flusher.join();
+    drain();
+}
+
+void Logger::write(LogLevel level, const char* format, ...) {
+    if (!isEnabled(level)) return;
+
+    Record record;
+    record.level = level;
+    record.timeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - origin).count();
+    va_list args;
+    va_start(args, format);
+    vsnprintf(record.message, sizeof(record.message), format, args);
+    va_end(args);
+
+    ThreadQueue* queue = threadQueue();
+    record.thread = queue->index;
+    if (!running.load(std::memory_order_acquire)) {
+        writeRecord(record);
+        fflush(level >= LOG_LEVEL_WARN ? stderr : stdout);
+        return;
+    }
+    if (!queue->queue.tryPush(record)) {
+        queue->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Logger::writeRecord(const Record& record) {
+    FILE* out = record.level >= LOG_LEVEL_WARN ? stderr : stdout;
+    fprintf(out, "[%10.3f] %-5s #%d %s\n", record.timeMs / 1000.0, LEVEL_NAMES[record.level], record.thread, record.message);
+}
+
+// Poruke svih niti iz jednog prolaza, po vremenu
+void Logger::drain() {
+    std::vector<ThreadQueue*> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        snapshot = queues;
+    }
+
+    batch.clear();
+    long long dropped = 0;
+    for (size_t i = 0; i < snapshot.size(); i++) {
+        Record record;
+        while (snapshot[i]->queue.tryPop(record)) {
+            batch.push_back(record);
+        }
+        dropped += snapshot[i]->dropped.exchange(0, std::memory_order_relaxed);
+    }
+    if (batch.empty() && dropped == 0) return;
+
+    std::stable_sort(batch.begin(), batch.end(), [](const Record& a, const Record& b) { return a.timeMs < b.timeMs; });
+    for (size_t i = 0; i < batch.size(); i++) {
+        writeRecord(batch[i]);
+    }
+    if (dropped > 0) {
+        fprintf(stderr, "[log] odbaceno poruka (pun red): %lld\n", dropped);
+    }
+    fflush(stdout);
+    fflush(stderr);
+}
+
+void Logger::flushLoop() {
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (running) {
+        wake.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL_MS));
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+}
@@ -6,52 +6,85 @@
 
 #include "../Header/Util.h"
 #include "../Header/Game.h"
+#include "../Header/Options.h"
+#include "../Header/Bench.h"
+#include "../Header/FramePacer.h"
+#include "../Header/FrameTelemetry.h"
+#include "../Header/LatencyProbe.h"
+#include "../Header/Logger.h"
+#include "../Header/LeaderboardServer.h"
+#include "../Header/ScoreTool.h"
+#include "../Header/StartupProfiler.h"
 
 
 Game* game = nullptr;
+FrameTelemetry* telemetry = nullptr;
+LatencyProbe* latencyProbe = nullptr;
 
+// Callback-ovi samo salju ulaz simulaciji (Game::postInput); stanje igre menja njena nit
 void charCallback(GLFWwindow* window, unsigned int codepoint) {
     if (game) {
-        game->onCharEntered(codepoint);
+        game->postInput(InputEvent::CHAR, 0, codepoint);
     }
 }
 
 void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
     if ((key == GLFW_KEY_ENTER || key == GLFW_KEY_KP_ENTER) && action == GLFW_PRESS) {
         if (game) {
-            game->dropBlock();
+            game->postInput(InputEvent::DROP);
         }
     }
     
     if ((mods & GLFW_MOD_CONTROL) && key == GLFW_KEY_R && action == GLFW_PRESS) {
         if (game) {
-            game->restart();
+            game->postInput(InputEvent::RESTART);
         }
     }
     
+    if (key == GLFW_KEY_F9 && action == GLFW_PRESS && telemetry) {
+        telemetry->printReport();
+        if (latencyProbe) latencyProbe->printReport();
+    }
+
     if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS) {
         glfwSetWindowShouldClose(window, true);
     }
 
-    if (game && game->getGameState() == GAME_OVER) {
-        if (action == GLFW_PRESS || action == GLFW_REPEAT) {
-            game->onKeyPressed(key);
-        }
-        return;
+    // Unos imena - simulacija ga obradjuje samo na ekranu kraja igre
+    if (game && (action == GLFW_PRESS || action == GLFW_REPEAT)) {
+        game->postInput(InputEvent::KEY, key);
     }
 }
 
 void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
     if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
         if (game) {
-            game->dropBlock();
+            game->postInput(InputEvent::DROP);
         }
     }
 }
 
-int main()
+static long long microsecondsBetween(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+int main(int argc, char** argv)
 {
+    StartupProfiler& profiler = StartupProfiler::instance();
+
+    Options options;
+    if (!parseOptions(argc, argv, options)) return -1;
+    if (!options.bench.empty()) return runBenchmark(options);
+    if (!options.importScores.empty() || !options.exportScores.empty()) return runScoreTool(options);
+    if (options.leaderboardDaemonPort) return runLeaderboardDaemon(options);
+    if (options.runReportDays) return runHistoryReport(options);
+
+    // Poruke igre idu kroz asinhroni log; alati iznad pisu direktno
+    Logger::instance().start(options.logLevel);
+
+    profiler.begin("glfwInit");
     glfwInit();
+    profiler.end();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
@@ -59,13 +92,21 @@ int main()
     GLFWmonitor* primaryMonitor = glfwGetPrimaryMonitor();
     const GLFWvidmode* mode = glfwGetVideoMode(primaryMonitor);
     
+    profiler.begin("glfwCreateWindow");
     GLFWwindow* window = glfwCreateWindow(mode->width, mode->height, "CityBloxx 2D", primaryMonitor, NULL);
+    profiler.end();
     if (window == NULL) return endProgram("Prozor nije uspeo da se kreira.");
     glfwMakeContextCurrent(window);
+    if (options.swapInterval >= 0) glfwSwapInterval(options.swapInterval);
 
-    if (glewInit() != GLEW_OK) return endProgram("GLEW nije uspeo da se inicijalizuje.");
+    profiler.begin("glewInit");
+    GLenum glewStatus = glewInit();
+    profiler.end();
+    if (glewStatus != GLEW_OK) return endProgram("GLEW nije uspeo da se inicijalizuje.");
 
+    profiler.begin("loadCursor");
     GLFWcursor* myCursor = loadImageToCursor("Resources/cursor_mid.png");
+    profiler.end();
     if (myCursor) {
 		std::cout << "? Kursor ucitan uspešno." << std::endl;
         glfwSetCursor(window, myCursor);
@@ -81,48 +122,93 @@ int main()
 
     glClearColor(0.5f, 0.7f, 1.0f, 1.0f); 
     
-    game = new Game();
-    game->setAspectRatio((float)mode->width, (float)mode->height);
-    game->setWindowSize(mode->width, mode->height);
+    profiler.begin("Game");
+    game = new Game(mode->width, mode->height, options);
+    profiler.end();
+
+    profiler.finish();
+    profiler.printSummary();
+    if (!options.startupTracePath.empty()) {
+        profiler.writeChromeTrace(options.startupTracePath.c_str());
+    }
+    if (options.startupBudgetMs > 0.0 && profiler.getTotalMs() > options.startupBudgetMs) {
+        std::cout << "Pokretanje je trajalo " << profiler.getTotalMs() << " ms, budzet je "
+                  << options.startupBudgetMs << " ms." << std::endl;
+        delete game;
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        return 1;
+    }
     
     const double TARGET_FPS = 75.0;
-    const double FRAME_TIME = 1.0 / TARGET_FPS;
-    double lastTime = glfwGetTime();
-    double frameStartTime = lastTime;
+    FramePacer pacer(TARGET_FPS);
+    telemetry = new FrameTelemetry(options.telemetryPath, options.telemetryIntervalSeconds);
+    if (options.latencyProbe) latencyProbe = new LatencyProbe(options.latencyProbeGpu);
+    // Simulacija ide na svojoj niti; ova nit samo crta poslednji objavljeni snapshot
+    game->startSimulation(telemetry);
+    std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+    bool idle = false;
 
     while (!glfwWindowShouldClose(window))
     {
-        frameStartTime = glfwGetTime();
+        // Ekran kraja igre: scena stoji, pa se umesto 75 frejmova u sekundi ceka dogadjaj
+        // (ulaz, simulacija javlja novo stanje) ili treptaj kursora
+        if (game->isIdle() && !game->needsRedraw()) {
+            idle = true;
+            glfwWaitEventsTimeout(game->getIdleTimeout());
+            telemetry->tick();
+            continue;
+        }
+        if (idle) {
+            idle = false;
+            pacer.resume();
+            frameStart = std::chrono::steady_clock::now();
+        }
 
-        double currentTime = glfwGetTime();
-        float deltaTime = static_cast<float>(currentTime - lastTime);
-        lastTime = currentTime;
-        
-        if (deltaTime > 0.1f) deltaTime = 0.1f;
-        if (deltaTime < 1e-4f) deltaTime = 1e-4f;
-        
         glClear(GL_COLOR_BUFFER_BIT);
         
-        game->update(deltaTime);
+        std::chrono::steady_clock::time_point renderStart = std::chrono::steady_clock::now();
+        double probeRenderStart = latencyProbe ? glfwGetTime() : 0.0;
         game->render();
+        std::chrono::steady_clock::time_point renderEnd = std::chrono::steady_clock::now();
+        int state = game->getGameState();
+
+        InputTiming inputTiming;
+        if (latencyProbe && game->takeShownInput(inputTiming)) {
+            latencyProbe->frameRendered(inputTiming, probeRenderStart, glfwGetTime());
+        }
 
         glfwSwapBuffers(window);
+        if (latencyProbe && latencyProbe->swapReturned(glfwGetTime())) {
+            glFinish();
+            latencyProbe->gpuFinished(glfwGetTime());
+        }
         glfwPollEvents();
 
-        double frameEndTime = glfwGetTime();
-        double frameDuration = frameEndTime - frameStartTime;
+        pacer.wait();
 
-        if (frameDuration < FRAME_TIME) {
-            double sleepTime = FRAME_TIME - frameDuration;
-            std::this_thread::sleep_for(
-                std::chrono::duration<double>(sleepTime)
-            );
-        }
+        std::chrono::steady_clock::time_point frameEnd = std::chrono::steady_clock::now();
+        telemetry->record(state, FrameTelemetry::METRIC_RENDER, microsecondsBetween(renderStart, renderEnd));
+        telemetry->record(state, FrameTelemetry::METRIC_FRAME, microsecondsBetween(frameStart, frameEnd));
+        telemetry->tick();
+        frameStart = frameEnd;
+    }
+    game->stopSimulation();
+    pacer.printReport();
+    if (latencyProbe) {
+        latencyProbe->printReport();
+        delete latencyProbe;
+        latencyProbe = nullptr;
     }
+    telemetry->finish();
+    delete telemetry;
+    telemetry = nullptr;
     
+    game->shutdown();
     delete game;
 
     glfwDestroyWindow(window);
     glfwTerminate();
+    Logger::instance().stop();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "../Header/MappedFile.h"
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile()
+    : file(INVALID_HANDLE_VALUE), mapping(nullptr), view(nullptr), length(0)
+{
+}
+
+bool MappedFile::open(const std::string& path, size_t minSize) {
+    close();
+
+    file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+        OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "Ne mogu da otvorim fajl: " << path << std::endl;
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    size_t size = static_cast<size_t>(fileSize.QuadPart);
+    if (size < minSize) size = minSize;
+    if (size == 0) {
+        close();
+        return false;
+    }
+
+    // Mapiranje vece od fajla ga prosiruje
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>((unsigned long long)size >> 32), static_cast<DWORD>(size & 0xFFFFFFFFu), nullptr);
+    if (!mapping) {
+        std::cerr << "Ne mogu da mapiram fajl: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    view = static_cast<unsigned char*>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size));
+    if (!view) {
+        std::cerr << "Ne mogu da mapiram fajl: " << path << std::endl;
+        close();
+        return false;
+    }
+    length = size;
+    return true;
+}
+
+void MappedFile::close() {
+    if (view) UnmapViewOfFile(view);
+    if (mapping) CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+    view = nullptr;
+    mapping = nullptr;
+    file = INVALID_HANDLE_VALUE;
+    length = 0;
+}
+
+bool MappedFile::flush(bool sync) {
+    if (!view) return false;
+    if (!FlushViewOfFile(view, length)) return false;
+    return !sync || FlushFileBuffers(file);
+}
+
+#else
+
+MappedFile::MappedFile()
+    : fd(-1), view(nullptr), length(0)
+{
+}
+
+bool MappedFile::open(const std::string& path, size_t minSize) {
+    close();
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        std::cerr << "Ne mogu da otvorim fajl: " << path << std::endl;
+        return false;
+    }
+
+    struct stat info;
+    fstat(fd, &info);
+    size_t size = static_cast<size_t>(info.st_size);
+    if (size < minSize) {
+        if (ftruncate(fd, static_cast<off_t>(minSize)) != 0) {
+            std::cerr << "Ne mogu da prosirim fajl: " << path << std::endl;
+            close();
+            return false;
+        }
+        size = minSize;
+    }
+    if (size == 0) {
+        close();
+        return false;
+    }
+
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+        std::cerr << "Ne mogu da mapiram fajl: " << path << std::endl;
+        close();
+        return false;
+    }
+    view = static_cast<unsigned char*>(address);
+    length = size;
+    return true;
+}
+
+void MappedFile::close() {
+    if (view) munmap(view, length);
+    if (fd >= 0) ::close(fd);
+    view = nullptr;
+    fd = -1;
+    length = 0;
+}
+
+bool MappedFile::flush(bool sync) {
+    if (!view) return false;
+    return msync(view, length, sync ? MS_SYNC : MS_ASYNC) == 0;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
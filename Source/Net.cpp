@@ -0,0 +1,153 @@
+#include "../Header/Net.h"
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+typedef int SocketLength;
+const SocketHandle INVALID_SOCKET_HANDLE = INVALID_SOCKET;
+#else
+#include <arpa/inet.h>
+#include <csignal>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef socklen_t SocketLength;
+const SocketHandle INVALID_SOCKET_HANDLE = -1;
+#endif
+
+#ifdef MSG_NOSIGNAL
+static const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+static const int SEND_FLAGS = 0;
+#endif
+
+bool netInit() {
+#ifdef _WIN32
+    WSADATA data;
+    if (WSAStartup(MAKEWORD(2, 2), &data) != 0) {
+        std::cerr << "WSAStartup nije uspeo" << std::endl;
+        return false;
+    }
+#else
+    signal(SIGPIPE, SIG_IGN);
+#endif
+    return true;
+}
+
+void netShutdown() {
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+static sockaddr_in loopbackAddress(int port) {
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<unsigned short>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return address;
+}
+
+// Odgovori su mali i odmah potrebni - bez Nagle kasnjenja
+static void setNoDelay(SocketHandle socket) {
+    int enabled = 1;
+    setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&enabled), sizeof(enabled));
+}
+
+SocketHandle netListenLoopback(int port, int* boundPort) {
+    SocketHandle listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listener == INVALID_SOCKET_HANDLE) return INVALID_SOCKET_HANDLE;
+
+#ifndef _WIN32
+    // Ponovno pokretanje servera odmah posle gasenja (port je jos u TIME_WAIT); na Windows-u bi
+    // SO_REUSEADDR dozvolio dva servera na istom portu, a TIME_WAIT tamo ne blokira bind
+    int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+#endif
+
+    sockaddr_in address = loopbackAddress(port);
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 16) != 0) {
+        std::cerr << "Ne mogu da otvorim port " << port << std::endl;
+        netClose(listener);
+        return INVALID_SOCKET_HANDLE;
+    }
+
+    if (boundPort) {
+        SocketLength length = sizeof(address);
+        getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length);
+        *boundPort = ntohs(address.sin_port);
+    }
+    return listener;
+}
+
+SocketHandle netAccept(SocketHandle listener, int timeoutMs) {
+    fd_set readable;
+    FD_ZERO(&readable);
+    FD_SET(listener, &readable);
+    timeval timeout;
+    timeout.tv_sec = timeoutMs / 1000;
+    timeout.tv_usec = (timeoutMs % 1000) * 1000;
+
+    if (select(static_cast<int>(listener) + 1, &readable, nullptr, nullptr, &timeout) <= 0) return INVALID_SOCKET_HANDLE;
+
+    SocketHandle client = accept(listener, nullptr, nullptr);
+    if (client != INVALID_SOCKET_HANDLE) setNoDelay(client);
+    return client;
+}
+
+SocketHandle netConnectLoopback(int port) {
+    SocketHandle connection = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (connection == INVALID_SOCKET_HANDLE) return INVALID_SOCKET_HANDLE;
+
+    sockaddr_in address = loopbackAddress(port);
+    if (connect(connection, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        netClose(connection);
+        return INVALID_SOCKET_HANDLE;
+    }
+    setNoDelay(connection);
+    return connection;
+}
+
+bool netSendAll(SocketHandle socket, const void* data, size_t length) {
+    const char* bytes = static_cast<const char*>(data);
+    while (length > 0) {
+        int sent = send(socket, bytes, static_cast<int>(length), SEND_FLAGS);
+        if (sent <= 0) return false;
+        bytes += sent;
+        length -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool netReceiveAll(SocketHandle socket, void* data, size_t length) {
+    char* bytes = static_cast<char*>(data);
+    while (length > 0) {
+        int received = recv(socket, bytes, static_cast<int>(length), 0);
+        if (received <= 0) return false;
+        bytes += received;
+        length -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+void netShutdownSocket(SocketHandle socket) {
+#ifdef _WIN32
+    shutdown(socket, SD_BOTH);
+#else
+    shutdown(socket, SHUT_RDWR);
+#endif
+}
+
+void netClose(SocketHandle socket) {
+#ifdef _WIN32
+    closesocket(socket);
+#else
+    close(socket);
+#endif
+}
@@ -0,0 +1,221 @@
+#include "../Header/Options.h"
+#include "../Header/LeaderboardProtocol.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// Ako argument pocinje sa "name", vraca vrednost posle '=' (ili "" ako je samo flag)
+static const char* matchOption(const char* arg, const char* name) {
+    size_t length = strlen(name);
+    if (strncmp(arg, name, length) != 0) return nullptr;
+    if (arg[length] == '\0') return "";
+    if (arg[length] == '=') return arg + length + 1;
+    return nullptr;
+}
+
+static bool parseDouble(const char* text, double& value) {
+    char* end = nullptr;
+    value = strtod(text, &end);
+    return end != text && *end == '\0';
+}
+
+// Bez vrednosti = podrazumevani port rang liste
+static bool parsePort(const char* text, int& port) {
+    if (*text == '\0') {
+        port = LEADERBOARD_DEFAULT_PORT;
+        return true;
+    }
+    double value;
+    if (!parseDouble(text, value) || value < 1.0 || value > 65535.0) return false;
+    port = static_cast<int>(value);
+    return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = nullptr;
+
+        if ((value = matchOption(arg, "--startup-trace")) != nullptr) {
+            options.startupTracePath = *value ? value : "startup_trace.json";
+        }
+        else if ((value = matchOption(arg, "--startup-budget-ms")) != nullptr) {
+            if (!parseDouble(value, options.startupBudgetMs) || options.startupBudgetMs < 0.0) {
+                std::cout << "Neispravna vrednost za --startup-budget-ms: " << value << std::endl;
+                return false;
+            }
+        }
+        else if ((value = matchOption(arg, "--telemetry")) != nullptr) {
+            options.telemetryPath = *value ? value : "telemetry.csv";
+        }
+        else if ((value = matchOption(arg, "--telemetry-interval-s")) != nullptr) {
+            double interval;
+            if (!parseDouble(value, interval) || interval < 1.0) {
+                std::cout << "Neispravna vrednost za --telemetry-interval-s: " << value << std::endl;
+                return false;
+            }
+            options.telemetryIntervalSeconds = static_cast<int>(interval);
+        }
+        else if ((value = matchOption(arg, "--texture-quality")) != nullptr) {
+            double quality;
+            if (!parseDouble(value, quality) || quality < 0.0) {
+                std::cout << "Neispravna vrednost za --texture-quality: " << value << std::endl;
+                return false;
+            }
+            options.textureQuality = static_cast<float>(quality);
+        }
+        else if ((value = matchOption(arg, "--texture-budget-mb")) != nullptr) {
+            double budget;
+            if (!parseDouble(value, budget) || budget < 1.0) {
+                std::cout << "Neispravna vrednost za --texture-budget-mb: " << value << std::endl;
+                return false;
+            }
+            options.textureBudgetMb = static_cast<int>(budget);
+        }
+        else if ((value = matchOption(arg, "--score-fsync")) != nullptr) {
+            if (strcmp(value, "never") == 0) options.scoreFsync = FSYNC_NEVER;
+            else if (strcmp(value, "batch") == 0) options.scoreFsync = FSYNC_BATCH;
+            else if (strcmp(value, "interval") == 0) options.scoreFsync = FSYNC_INTERVAL;
+            else {
+                std::cout << "Neispravna vrednost za --score-fsync: " << value << std::endl;
+                return false;
+            }
+        }
+        else if ((value = matchOption(arg, "--score-fsync-interval-ms")) != nullptr) {
+            double interval;
+            if (!parseDouble(value, interval) || interval < 1.0) {
+                std::cout << "Neispravna vrednost za --score-fsync-interval-ms: " << value << std::endl;
+                return false;
+            }
+            options.scoreFsyncIntervalMs = static_cast<int>(interval);
+        }
+        else if ((value = matchOption(arg, "--import-scores")) != nullptr && *value) {
+            // Vise fajlova: ponovljena opcija ili lista odvojena zarezima
+            const char* start = value;
+            while (*start) {
+                const char* comma = strchr(start, ',');
+                size_t length = comma ? static_cast<size_t>(comma - start) : strlen(start);
+                if (length > 0) options.importScores.push_back(std::string(start, length));
+                start += length;
+                if (*start == ',') start++;
+            }
+        }
+        else if ((value = matchOption(arg, "--export-scores")) != nullptr && *value) {
+            options.exportScores = value;
+        }
+        else if ((value = matchOption(arg, "--merge")) != nullptr) {
+            if (strcmp(value, "latest") == 0) options.mergeBest = false;
+            else if (strcmp(value, "best") == 0) options.mergeBest = true;
+            else {
+                std::cout << "Neispravna vrednost za --merge: " << value << std::endl;
+                return false;
+            }
+        }
+        else if ((value = matchOption(arg, "--score-store")) != nullptr && *value) {
+            options.scoreStorePath = value;
+        }
+        else if ((value = matchOption(arg, "--run-history")) != nullptr && *value) {
+            options.runHistoryPath = value;
+        }
+        else if ((value = matchOption(arg, "--run-report")) != nullptr) {
+            double days = 7.0;
+            if (*value && (!parseDouble(value, days) || days < 1.0)) {
+                std::cout << "Neispravna vrednost za --run-report: " << value << std::endl;
+                return false;
+            }
+            options.runReportDays = static_cast<int>(days);
+        }
+        else if ((value = matchOption(arg, "--bench")) != nullptr && *value) {
+            options.bench = value;
+        }
+        else if ((value = matchOption(arg, "--bench-count")) != nullptr) {
+            double benchCount;
+            if (!parseDouble(value, benchCount) || benchCount < 1.0) {
+                std::cout << "Neispravna vrednost za --bench-count: " << value << std::endl;
+                return false;
+            }
+            options.benchCount = static_cast<long long>(benchCount);
+        }
+        else if ((value = matchOption(arg, "--leaderboard-daemon")) != nullptr) {
+            if (!parsePort(value, options.leaderboardDaemonPort)) {
+                std::cout << "Neispravna vrednost za --leaderboard-daemon: " << value << std::endl;
+                return false;
+            }
+        }
+        else if ((value = matchOption(arg, "--leaderboard-port")) != nullptr) {
+            if (!parsePort(value, options.leaderboardPort)) {
+                std::cout << "Neispravna vrednost za --leaderboard-port: " << value << std::endl;
+                return false;
+            }
+        }
+        else if ((value = matchOption(arg, "--record-input")) != nullptr) {
+            options.inputRecordPath = *value ? value : "input.csv";
+        }
+        else if ((value = matchOption(arg, "--replay-input")) != nullptr && *value) {
+            options.inputReplayPath = value;
+        }
+        else if ((value = matchOption(arg, "--latency-probe")) != nullptr) {
+            if (*value && strcmp(value, "gpu") != 0) {
+                std::cout << "Neispravna vrednost za --latency-probe: " << value << std::endl;
+                return false;
+            }
+            options.latencyProbe = true;
+            options.latencyProbeGpu = *value != '\0';
+        }
+        else if ((value = matchOption(arg, "--swap-interval")) != nullptr) {
+            double interval;
+            if (!parseDouble(value, interval) || interval < 0.0 || interval > 4.0) {
+                std::cout << "Neispravna vrednost za --swap-interval: " << value << std::endl;
+                return false;
+            }
+            options.swapInterval = static_cast<int>(interval);
+        }
+        else if ((value = matchOption(arg, "--log-level")) != nullptr) {
+            if (strcmp(value, "debug") == 0) options.logLevel = LOG_LEVEL_DEBUG;
+            else if (strcmp(value, "info") == 0) options.logLevel = LOG_LEVEL_INFO;
+            else if (strcmp(value, "warn") == 0) options.logLevel = LOG_LEVEL_WARN;
+            else if (strcmp(value, "error") == 0) options.logLevel = LOG_LEVEL_ERROR;
+            else {
+                std::cout << "Neispravna vrednost za --log-level: " << value << std::endl;
+                return false;
+            }
+        }
+        else if (strcmp(arg, "--help") == 0) {
+            printUsage();
+            return false;
+        }
+        else {
+            std::cout << "Nepoznata opcija: " << arg << std::endl;
+            printUsage();
+            return false;
+        }
+    }
+    return true;
+}
+
+void printUsage() {
+    std::cout << "Opcije:\n"
+              << "  --startup-trace[=putanja]   Chrome trace JSON pokretanja (podrazumevano startup_trace.json)\n"
+              << "  --startup-budget-ms=N       Izlaz sa greskom ako pokretanje traje duze od N ms\n"
+              << "  --telemetry[=putanja]       Percentili frejma/update/render u CSV (telemetry.csv), F9 = ispis u konzolu\n"
+              << "  --telemetry-interval-s=N    Koliko cesto se telemetrija dopisuje u fajl (60 podrazumevano)\n"
+              << "  --texture-quality=Q         Velicina tekstura = Q x velicina na ekranu (1 podrazumevano, 0 = puna)\n"
+              << "  --texture-budget-mb=N       Budzet memorije za pozadine i dekoracije (48 podrazumevano)\n"
+              << "  --score-fsync=never|batch|interval  Kada se rezultati upisuju na disk (batch podrazumevano)\n"
+              << "  --score-fsync-interval-ms=N  Interval za --score-fsync=interval (1000 podrazumevano)\n"
+              << "  --import-scores=a.csv[,b.csv...]  Spaja CSV fajlove u skladiste rezultata (bez igre)\n"
+              << "  --export-scores=izlaz.csv   Izvozi skladiste rezultata u CSV (bez igre)\n"
+              << "  --merge=latest|best         Pri spajanju vazi poslednji (podrazumevano) ili bolji rezultat\n"
+              << "  --score-store=putanja       Skladiste rezultata (PlayersScore.bin podrazumevano)\n"
+              << "  --run-history=putanja       Istorija svih partija (RunHistory.bin podrazumevano)\n"
+              << "  --run-report[=dani]         Najbolji rezultat po igracu iz istorije za poslednjih N dana (7, bez igre)\n"
+              << "  --bench=ime [--bench-count=N]  Headless benchmark (leaderboard, leaderboard-service, run-history, tower-stability, physics, particles, tower-sway)\n"
+              << "  --leaderboard-daemon[=port]  Server rang liste za vise kioska (7420 podrazumevano, bez igre)\n"
+              << "  --leaderboard-port[=port]   Rezultati se salju serveru rang liste (7420 podrazumevano)\n"
+              << "  --record-input[=putanja]    Snima ulaz po koracima simulacije (input.csv podrazumevano)\n"
+              << "  --replay-input=putanja      Pusta snimljen ulaz (ista partija; tastatura i mis se ignorisu)\n"
+              << "  --latency-probe[=gpu]       Latencija ulaz -> slika po fazama (gpu = i glFinish posle swap-a), F9/izlaz\n"
+              << "  --swap-interval=N           glfwSwapInterval (0 = bez vsync, 1 = vsync; podrazumevano drajver)\n"
+              << "  --log-level=debug|info|warn|error  Najnizi nivo poruka igre (info; debug samo u debug build-u)\n"
+              << std::endl;
+}
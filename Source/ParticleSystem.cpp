@@ -0,0 +1,127 @@
+#include "../Header/ParticleSystem.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLES_SSE 1
+#include <xmmintrin.h>
+#endif
+
+static const float DUST_GRAVITY = -0.6f;     // Prasina pada sporije od blokova
+static const float DUST_DRAG = 2.5f;         // Gubitak brzine u sekundi (deo brzine)
+static const float DUST_SPEED = 0.2f;        // Brzina cestica po jedinici jacine udara
+static const float FADE_RATE = 2.0f;         // Providnost = preostali zivot * FADE_RATE (najvise 1)
+static const float MIN_LIFE = 0.5f;
+static const float LIFE_RANGE = 0.7f;
+static const float MIN_SIZE = 0.006f;
+static const float SIZE_RANGE = 0.012f;
+
+ParticleSystem::ParticleSystem(size_t capacityValue)
+    : capacity(capacityValue), count(0), randomState(0x9E3779B9u)
+{
+    size_t padded = (capacity + 3) & ~static_cast<size_t>(3);
+    positionX.assign(padded, 0.0f);
+    positionY.assign(padded, 0.0f);
+    velocityX.assign(padded, 0.0f);
+    velocityY.assign(padded, 0.0f);
+    life.assign(padded, 0.0f);
+    size.assign(padded, 0.0f);
+    instances.assign(padded * INSTANCE_FLOATS, 0.0f);
+}
+
+// xorshift32 -> [0, 1)
+float ParticleSystem::nextRandom() {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return (randomState >> 8) * (1.0f / 16777216.0f);
+}
+
+size_t ParticleSystem::emitDust(float x, float y, float width, int particles, float strength) {
+    if (particles <= 0) return 0;
+    size_t added = std::min(static_cast<size_t>(particles), capacity - count);
+    for (size_t k = 0; k < added; k++) {
+        size_t i = count++;
+        float along = nextRandom() - 0.5f;
+        positionX[i] = x + along * width;
+        positionY[i] = y + nextRandom() * 0.01f;
+        // Od sredine udara ka spolja, pa navise
+        velocityX[i] = (along * 1.2f + (nextRandom() - 0.5f) * 0.6f) * strength * DUST_SPEED;
+        velocityY[i] = nextRandom() * 0.5f * strength * DUST_SPEED;
+        life[i] = MIN_LIFE + nextRandom() * LIFE_RANGE;
+        size[i] = MIN_SIZE + nextRandom() * SIZE_RANGE;
+    }
+    return added;
+}
+
+// Mrtva cestica se menja poslednjom zivom - redosled nije bitan, niz ostaje gust
+void ParticleSystem::removeDead() {
+    size_t i = 0;
+    while (i < count) {
+        if (life[i] > 0.0f) {
+            i++;
+            continue;
+        }
+        count--;
+        positionX[i] = positionX[count];
+        positionY[i] = positionY[count];
+        velocityX[i] = velocityX[count];
+        velocityY[i] = velocityY[count];
+        life[i] = life[count];
+        size[i] = size[count];
+    }
+}
+
+void ParticleSystem::update(float dt) {
+    removeDead();
+    if (count == 0) return;
+
+    float damping = std::max(0.0f, 1.0f - DUST_DRAG * dt);
+    size_t groups = (count + 3) / 4;
+
+#ifdef PARTICLES_SSE
+    const __m128 dtVector = _mm_set1_ps(dt);
+    const __m128 dampingVector = _mm_set1_ps(damping);
+    const __m128 gravityStep = _mm_set1_ps(DUST_GRAVITY * dt);
+    const __m128 fadeRate = _mm_set1_ps(FADE_RATE);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (size_t g = 0; g < groups; g++) {
+        size_t i = g * 4;
+        __m128 vx = _mm_mul_ps(_mm_loadu_ps(&velocityX[i]), dampingVector);
+        __m128 vy = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&velocityY[i]), dampingVector), gravityStep);
+        __m128 x = _mm_add_ps(_mm_loadu_ps(&positionX[i]), _mm_mul_ps(vx, dtVector));
+        __m128 y = _mm_add_ps(_mm_loadu_ps(&positionY[i]), _mm_mul_ps(vy, dtVector));
+        __m128 remaining = _mm_sub_ps(_mm_loadu_ps(&life[i]), dtVector);
+        _mm_storeu_ps(&velocityX[i], vx);
+        _mm_storeu_ps(&velocityY[i], vy);
+        _mm_storeu_ps(&positionX[i], x);
+        _mm_storeu_ps(&positionY[i], y);
+        _mm_storeu_ps(&life[i], remaining);
+
+        // 4 cestice x 4 polja -> 4 instance (transpozicija u registrima)
+        __m128 scale = _mm_loadu_ps(&size[i]);
+        __m128 alpha = _mm_max_ps(zero, _mm_min_ps(one, _mm_mul_ps(remaining, fadeRate)));
+        _MM_TRANSPOSE4_PS(x, y, scale, alpha);
+        float* out = &instances[i * INSTANCE_FLOATS];
+        _mm_storeu_ps(out, x);
+        _mm_storeu_ps(out + 4, y);
+        _mm_storeu_ps(out + 8, scale);
+        _mm_storeu_ps(out + 12, alpha);
+    }
+#else
+    const float gravityStep = DUST_GRAVITY * dt;
+    for (size_t i = 0; i < groups * 4; i++) {
+        velocityX[i] *= damping;
+        velocityY[i] = velocityY[i] * damping + gravityStep;
+        positionX[i] += velocityX[i] * dt;
+        positionY[i] += velocityY[i] * dt;
+        life[i] -= dt;
+
+        float* out = &instances[i * INSTANCE_FLOATS];
+        out[0] = positionX[i];
+        out[1] = positionY[i];
+        out[2] = size[i];
+        out[3] = std::max(0.0f, std::min(1.0f, life[i] * FADE_RATE));
+    }
+#endif
+}
@@ -0,0 +1,571 @@
+#include "../Header/Physics2D.h"
+#include <algorithm>
+#include <utility>
+
+static const float ALLOWED_PENETRATION = 0.005f;
+static const float BIAS_FACTOR = 0.2f;
+static const float SLEEP_LINEAR_SPEED = 0.02f;
+static const float SLEEP_ANGULAR_SPEED = 0.05f;
+static const float SLEEP_TIME = 0.5f;
+static const float WIDE_STATIC_REACH = 2.0f;      // Vece staticko telo bi prosirilo pojas za sva tela
+static const float WARM_START_DISTANCE = 0.02f;   // Ista tacka kontakta ako se pomerila manje od ovoga
+
+static float dot(const Vec2& a, const Vec2& b) { return a.x * b.x + a.y * b.y; }
+static float cross(const Vec2& a, const Vec2& b) { return a.x * b.y - a.y * b.x; }
+static Vec2 cross(float w, const Vec2& r) { return Vec2(-w * r.y, w * r.x); }
+static Vec2 absolute(const Vec2& v) { return Vec2(fabsf(v.x), fabsf(v.y)); }
+static float reachOf(const RigidBody& body) { return body.halfSize.x + body.halfSize.y; }
+
+static void removeId(std::vector<int>& ids, int id) {
+    ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+}
+
+// Rotacija: kolone su lokalne ose x i y u svetu
+struct Rotation {
+    Vec2 col1, col2;
+
+    explicit Rotation(float angle) {
+        float c = cosf(angle), s = sinf(angle);
+        col1 = Vec2(c, s);
+        col2 = Vec2(-s, c);
+    }
+    Vec2 apply(const Vec2& v) const { return Vec2(col1.x * v.x + col2.x * v.y, col1.y * v.x + col2.y * v.y); }
+    Vec2 applyTransposed(const Vec2& v) const { return Vec2(dot(col1, v), dot(col2, v)); }
+};
+
+// Ivica druge kutije koja je najvise okrenuta ka referentnoj normali
+static void incidentEdge(Vec2 edge[2], const Vec2& h, const Vec2& position, const Rotation& rotation, const Vec2& normal) {
+    Vec2 n = -rotation.applyTransposed(normal);
+    Vec2 nAbs = absolute(n);
+    if (nAbs.x > nAbs.y) {
+        if (n.x > 0.0f) {
+            edge[0] = Vec2(h.x, -h.y);
+            edge[1] = Vec2(h.x, h.y);
+        }
+        else {
+            edge[0] = Vec2(-h.x, h.y);
+            edge[1] = Vec2(-h.x, -h.y);
+        }
+    }
+    else {
+        if (n.y > 0.0f) {
+            edge[0] = Vec2(h.x, h.y);
+            edge[1] = Vec2(-h.x, h.y);
+        }
+        else {
+            edge[0] = Vec2(-h.x, -h.y);
+            edge[1] = Vec2(h.x, -h.y);
+        }
+    }
+    edge[0] = position + rotation.apply(edge[0]);
+    edge[1] = position + rotation.apply(edge[1]);
+}
+
+// Deo duzi sa strane dot(normal, v) <= offset
+static int clipSegment(Vec2 out[2], const Vec2 in[2], const Vec2& normal, float offset) {
+    int count = 0;
+    float distance0 = dot(normal, in[0]) - offset;
+    float distance1 = dot(normal, in[1]) - offset;
+    if (distance0 <= 0.0f) out[count++] = in[0];
+    if (distance1 <= 0.0f) out[count++] = in[1];
+    if (distance0 * distance1 < 0.0f) {
+        float t = distance0 / (distance0 - distance1);
+        out[count++] = in[0] + (in[1] - in[0]) * t;
+    }
+    return count;
+}
+
+// SAT: razdvajanje po 4 ose (po dve ivice svake kutije); ako se nigde ne razdvajaju, osa sa
+// najmanjim prodiranjem daje referentnu ivicu, a ivica druge kutije se odseca na njene bocne ravni
+int PhysicsWorld::collideBoxes(const RigidBody& a, const RigidBody& b, Manifold& manifold) {
+    Rotation rotationA(a.angle), rotationB(b.angle);
+    Vec2 d = b.position - a.position;
+    Vec2 dA = rotationA.applyTransposed(d);
+    Vec2 dB = rotationB.applyTransposed(d);
+
+    // C = RA^T * RB i njegove apsolutne vrednosti
+    float c11 = dot(rotationA.col1, rotationB.col1), c12 = dot(rotationA.col1, rotationB.col2);
+    float c21 = dot(rotationA.col2, rotationB.col1), c22 = dot(rotationA.col2, rotationB.col2);
+    float a11 = fabsf(c11), a12 = fabsf(c12), a21 = fabsf(c21), a22 = fabsf(c22);
+
+    Vec2 faceA(fabsf(dA.x) - a.halfSize.x - (a11 * b.halfSize.x + a12 * b.halfSize.y),
+        fabsf(dA.y) - a.halfSize.y - (a21 * b.halfSize.x + a22 * b.halfSize.y));
+    if (faceA.x > 0.0f || faceA.y > 0.0f) return 0;
+    Vec2 faceB(fabsf(dB.x) - b.halfSize.x - (a11 * a.halfSize.x + a21 * a.halfSize.y),
+        fabsf(dB.y) - b.halfSize.y - (a12 * a.halfSize.x + a22 * a.halfSize.y));
+    if (faceB.x > 0.0f || faceB.y > 0.0f) return 0;
+
+    // Prednost ivicama A (i x osi) kada su razdvajanja skoro jednaka - kontakti ne preskacu
+    const float RELATIVE_TOLERANCE = 0.95f;
+    const float ABSOLUTE_TOLERANCE = 0.01f;
+    enum { FACE_A_X, FACE_A_Y, FACE_B_X, FACE_B_Y } axis = FACE_A_X;
+    float separation = faceA.x;
+    Vec2 normal = dA.x > 0.0f ? rotationA.col1 : -rotationA.col1;
+    if (faceA.y > RELATIVE_TOLERANCE * separation + ABSOLUTE_TOLERANCE * a.halfSize.y) {
+        axis = FACE_A_Y;
+        separation = faceA.y;
+        normal = dA.y > 0.0f ? rotationA.col2 : -rotationA.col2;
+    }
+    if (faceB.x > RELATIVE_TOLERANCE * separation + ABSOLUTE_TOLERANCE * b.halfSize.x) {
+        axis = FACE_B_X;
+        separation = faceB.x;
+        normal = dB.x > 0.0f ? rotationB.col1 : -rotationB.col1;
+    }
+    if (faceB.y > RELATIVE_TOLERANCE * separation + ABSOLUTE_TOLERANCE * b.halfSize.y) {
+        axis = FACE_B_Y;
+        separation = faceB.y;
+        normal = dB.y > 0.0f ? rotationB.col2 : -rotationB.col2;
+    }
+
+    Vec2 frontNormal, sideNormal;
+    float front, sideNegative, sidePositive;
+    Vec2 incident[2];
+    switch (axis) {
+    case FACE_A_X:
+    case FACE_A_Y: {
+        bool xAxis = axis == FACE_A_X;
+        frontNormal = normal;
+        front = dot(a.position, frontNormal) + (xAxis ? a.halfSize.x : a.halfSize.y);
+        sideNormal = xAxis ? rotationA.col2 : rotationA.col1;
+        float side = dot(a.position, sideNormal);
+        float extent = xAxis ? a.halfSize.y : a.halfSize.x;
+        sideNegative = -side + extent;
+        sidePositive = side + extent;
+        incidentEdge(incident, b.halfSize, b.position, rotationB, frontNormal);
+        break;
+    }
+    default: {
+        bool xAxis = axis == FACE_B_X;
+        frontNormal = -normal;
+        front = dot(b.position, frontNormal) + (xAxis ? b.halfSize.x : b.halfSize.y);
+        sideNormal = xAxis ? rotationB.col2 : rotationB.col1;
+        float side = dot(b.position, sideNormal);
+        float extent = xAxis ? b.halfSize.y : b.halfSize.x;
+        sideNegative = -side + extent;
+        sidePositive = side + extent;
+        incidentEdge(incident, a.halfSize, a.position, rotationA, frontNormal);
+        break;
+    }
+    }
+
+    Vec2 clipped1[2], clipped2[2];
+    if (clipSegment(clipped1, incident, -sideNormal, sideNegative) < 2) return 0;
+    if (clipSegment(clipped2, clipped1, sideNormal, sidePositive) < 2) return 0;
+
+    manifold.normal = normal;
+    manifold.count = 0;
+    for (int i = 0; i < 2; i++) {
+        float pointSeparation = dot(frontNormal, clipped2[i]) - front;
+        if (pointSeparation > 0.0f) continue;
+        ContactPoint& point = manifold.points[manifold.count++];
+        point.separation = pointSeparation;
+        point.position = clipped2[i] - frontNormal * pointSeparation;   // Na referentnoj ivici
+        point.normalImpulse = point.tangentImpulse = 0.0f;
+    }
+    return manifold.count;
+}
+
+// Na osi n pomeraj je s(t) = (velocity.n) t + (curve.n) t^2, a preklapanje na toj osi je
+// |gap - s(t)| < r. Granice (koreni s(t) = gap +- r) dele [0, duration] na delove u kojima se
+// preklapanje ni na jednoj osi ne menja - prvi deo u kome se preklapaju na svim osama je udar.
+static int addCrossings(float* times, int count, float linear, float quadratic, float target, float duration) {
+    float roots[2];
+    int found = 0;
+    if (fabsf(quadratic) < 1e-12f) {
+        if (fabsf(linear) > 1e-12f) roots[found++] = target / linear;
+    }
+    else {
+        float discriminant = linear * linear + 4.0f * quadratic * target;
+        if (discriminant >= 0.0f) {
+            float root = sqrtf(discriminant);
+            roots[found++] = (-linear - root) / (2.0f * quadratic);
+            roots[found++] = (-linear + root) / (2.0f * quadratic);
+        }
+    }
+    for (int i = 0; i < found; i++) {
+        if (roots[i] > 0.0f && roots[i] < duration) times[count++] = roots[i];
+    }
+    return count;
+}
+
+bool PhysicsWorld::sweepBoxes(const RigidBody& a, const Vec2& velocity, const Vec2& curve, float duration,
+    const RigidBody& b, float& time) {
+    Rotation rotationA(a.angle), rotationB(b.angle);
+    const Vec2 axes[4] = { rotationA.col1, rotationA.col2, rotationB.col1, rotationB.col2 };
+    float radius[4], gap[4], linear[4], quadratic[4];
+    float times[18];
+    int count = 0;
+    times[count++] = 0.0f;
+    times[count++] = duration;
+    for (int i = 0; i < 4; i++) {
+        const Vec2& axis = axes[i];
+        radius[i] = fabsf(dot(rotationA.col1, axis)) * a.halfSize.x + fabsf(dot(rotationA.col2, axis)) * a.halfSize.y
+            + fabsf(dot(rotationB.col1, axis)) * b.halfSize.x + fabsf(dot(rotationB.col2, axis)) * b.halfSize.y;
+        gap[i] = dot(b.position - a.position, axis);
+        linear[i] = dot(velocity, axis);
+        quadratic[i] = dot(curve, axis);
+        count = addCrossings(times, count, linear[i], quadratic[i], gap[i] - radius[i], duration);
+        count = addCrossings(times, count, linear[i], quadratic[i], gap[i] + radius[i], duration);
+    }
+    std::sort(times, times + count);
+
+    for (int k = 0; k + 1 < count; k++) {
+        if (times[k + 1] <= times[k]) continue;
+        float t = 0.5f * (times[k] + times[k + 1]);
+        bool overlap = true;
+        for (int i = 0; i < 4 && overlap; i++) {
+            overlap = fabsf(gap[i] - (linear[i] + quadratic[i] * t) * t) < radius[i];
+        }
+        if (overlap) {
+            time = times[k];
+            return true;
+        }
+    }
+    return false;
+}
+
+PhysicsWorld::PhysicsWorld() : staticReach(0.0f), gravity(0.0f, -9.81f), iterations(10), awakeCount(0) {}
+
+int PhysicsWorld::createBody(const Vec2& position, const Vec2& halfSize, float density, float angle) {
+    RigidBody body;
+    body.position = position;
+    body.angle = angle;
+    body.angularVelocity = 0.0f;
+    body.halfSize = halfSize;
+    body.friction = 0.6f;
+    body.sleepTime = 0.0f;
+    body.consumedTime = 0.0f;
+    body.awake = density > 0.0f;
+    body.active = true;
+    if (density > 0.0f) {
+        float mass = density * 4.0f * halfSize.x * halfSize.y;
+        float width = 2.0f * halfSize.x, height = 2.0f * halfSize.y;
+        body.invMass = 1.0f / mass;
+        body.invInertia = 12.0f / (mass * (width * width + height * height));
+    }
+    else {
+        body.invMass = body.invInertia = 0.0f;
+    }
+
+    if (body.awake) awakeCount++;
+    int id;
+    if (!freeBodies.empty()) {
+        id = freeBodies.back();
+        freeBodies.pop_back();
+        bodies[id] = body;
+    }
+    else {
+        bodies.push_back(body);
+        id = static_cast<int>(bodies.size() - 1);
+    }
+
+    if (!body.isStatic()) {
+        dynamicBodies.push_back(id);
+    }
+    else if (reachOf(body) > WIDE_STATIC_REACH) {
+        wideStatics.push_back(id);
+    }
+    else {
+        // Spratovi nastaju odozdo navise, pa je ovo skoro uvek dodavanje na kraj
+        std::vector<int>::iterator it = std::upper_bound(staticBodies.begin(), staticBodies.end(), position.y,
+            [this](float y, int other) { return y < bodies[other].position.y; });
+        staticBodies.insert(it, id);
+        staticReach = std::max(staticReach, reachOf(body));
+    }
+    return id;
+}
+
+void PhysicsWorld::destroyBody(int id) {
+    if (id < 0 || !bodies[id].active) return;
+    if (bodies[id].awake) awakeCount--;
+    bodies[id].active = false;
+    bodies[id].awake = false;
+    freeBodies.push_back(id);
+    if (!bodies[id].isStatic()) {
+        removeId(dynamicBodies, id);
+    }
+    else if (reachOf(bodies[id]) > WIDE_STATIC_REACH) {
+        removeId(wideStatics, id);
+    }
+    else {
+        removeId(staticBodies, id);
+    }
+
+    // Tela koja su lezala na njemu moraju ponovo da padaju
+    for (size_t i = 0; i < manifolds.size(); i++) {
+        if (manifolds[i].bodyA == id) wake(manifolds[i].bodyB);
+        if (manifolds[i].bodyB == id) wake(manifolds[i].bodyA);
+    }
+    manifolds.erase(std::remove_if(manifolds.begin(), manifolds.end(),
+        [id](const Manifold& m) { return m.bodyA == id || m.bodyB == id; }), manifolds.end());
+}
+
+void PhysicsWorld::clear() {
+    bodies.clear();
+    freeBodies.clear();
+    manifolds.clear();
+    previousManifolds.clear();
+    dynamicBodies.clear();
+    staticBodies.clear();
+    wideStatics.clear();
+    staticReach = 0.0f;
+    awakeCount = 0;
+}
+
+void PhysicsWorld::wake(int id) {
+    RigidBody& body = bodies[id];
+    if (!body.active || body.isStatic()) return;
+    if (!body.awake) awakeCount++;
+    body.awake = true;
+    body.sleepTime = 0.0f;
+}
+
+// Parovi u kojima je bar jedno telo budno i dinamicko: budno telo se proverava sa dinamickim
+// telima, sirokim statickim telima i statickim telima ciji centar je u njegovom pojasu visine
+// (binarna pretraga), pa ni visok toranj ni uspavani blokovi ne kostaju nista dok ih nesto ne
+// dodirne. Dodir budi uspavano telo - ono se integrise vec u ovom koraku, a svoje parove dobija
+// od sledeceg.
+void PhysicsWorld::collide() {
+    previousManifolds.swap(manifolds);
+    manifolds.clear();
+
+    awakeBodies.clear();
+    for (size_t i = 0; i < dynamicBodies.size(); i++) {
+        if (bodies[dynamicBodies[i]].awake) awakeBodies.push_back(dynamicBodies[i]);
+    }
+
+    size_t movingCount = awakeBodies.size();
+    for (size_t k = 0; k < movingCount; k++) {
+        int moving = awakeBodies[k];
+        for (size_t j = 0; j < dynamicBodies.size(); j++) {
+            int other = dynamicBodies[j];
+            if (other == moving) continue;
+            // Par dva budna tela se obradi samo jednom
+            bool otherMoving = bodies[other].awake;
+            if (otherMoving && other < moving) continue;
+            collidePair(moving, other, otherMoving);
+        }
+        for (size_t j = 0; j < wideStatics.size(); j++) {
+            collidePair(moving, wideStatics[j], false);
+        }
+
+        const RigidBody& a = bodies[moving];
+        float band = reachOf(a) + staticReach;
+        std::vector<int>::const_iterator it = std::lower_bound(staticBodies.begin(), staticBodies.end(), a.position.y - band,
+            [this](int other, float y) { return bodies[other].position.y < y; });
+        for (; it != staticBodies.end() && bodies[*it].position.y <= a.position.y + band; ++it) {
+            collidePair(moving, *it, false);
+        }
+    }
+}
+
+void PhysicsWorld::collidePair(int moving, int other, bool otherMoving) {
+    // Grubo: krugovi oko kutija
+    const RigidBody& a = bodies[moving];
+    const RigidBody& b = bodies[other];
+    Vec2 d = b.position - a.position;
+    float reach = reachOf(a) + reachOf(b);
+    if (dot(d, d) > reach * reach) return;
+
+    // Manje telo je uvek A - isti par ima isti redosled iz koraka u korak (topli start)
+    Manifold manifold;
+    manifold.bodyA = std::min(moving, other);
+    manifold.bodyB = std::max(moving, other);
+    if (collideBoxes(bodies[manifold.bodyA], bodies[manifold.bodyB], manifold) == 0) return;
+
+    if (!otherMoving && !b.isStatic()) {
+        wake(other);
+        awakeBodies.push_back(other);
+    }
+    warmStart(manifold);
+    manifolds.push_back(manifold);
+}
+
+// Impulsi iz prethodnog koraka za istu tacku - slaganje blokova se smiri za nekoliko koraka
+void PhysicsWorld::warmStart(Manifold& manifold) {
+    for (size_t m = 0; m < previousManifolds.size(); m++) {
+        const Manifold& old = previousManifolds[m];
+        if (old.bodyA != manifold.bodyA || old.bodyB != manifold.bodyB) continue;
+        for (int i = 0; i < manifold.count; i++) {
+            for (int k = 0; k < old.count; k++) {
+                Vec2 delta = manifold.points[i].position - old.points[k].position;
+                if (dot(delta, delta) < WARM_START_DISTANCE * WARM_START_DISTANCE) {
+                    manifold.points[i].normalImpulse = old.points[k].normalImpulse;
+                    manifold.points[i].tangentImpulse = old.points[k].tangentImpulse;
+                    break;
+                }
+            }
+        }
+        return;
+    }
+}
+
+void PhysicsWorld::preStep(Manifold& manifold, float inverseDt) {
+    RigidBody& a = bodies[manifold.bodyA];
+    RigidBody& b = bodies[manifold.bodyB];
+    Vec2 tangent(manifold.normal.y, -manifold.normal.x);
+
+    for (int i = 0; i < manifold.count; i++) {
+        ContactPoint& point = manifold.points[i];
+        Vec2 rA = point.position - a.position;
+        Vec2 rB = point.position - b.position;
+
+        float rnA = dot(rA, manifold.normal), rnB = dot(rB, manifold.normal);
+        float kNormal = a.invMass + b.invMass + a.invInertia * (dot(rA, rA) - rnA * rnA) + b.invInertia * (dot(rB, rB) - rnB * rnB);
+        point.massNormal = 1.0f / kNormal;
+
+        float rtA = dot(rA, tangent), rtB = dot(rB, tangent);
+        float kTangent = a.invMass + b.invMass + a.invInertia * (dot(rA, rA) - rtA * rtA) + b.invInertia * (dot(rB, rB) - rtB * rtB);
+        point.massTangent = 1.0f / kTangent;
+
+        point.bias = -BIAS_FACTOR * inverseDt * std::min(0.0f, point.separation + ALLOWED_PENETRATION);
+
+        Vec2 impulse = manifold.normal * point.normalImpulse + tangent * point.tangentImpulse;
+        a.velocity -= impulse * a.invMass;
+        a.angularVelocity -= a.invInertia * cross(rA, impulse);
+        b.velocity += impulse * b.invMass;
+        b.angularVelocity += b.invInertia * cross(rB, impulse);
+    }
+}
+
+void PhysicsWorld::applyImpulse(Manifold& manifold) {
+    RigidBody& a = bodies[manifold.bodyA];
+    RigidBody& b = bodies[manifold.bodyB];
+    Vec2 tangent(manifold.normal.y, -manifold.normal.x);
+    float friction = sqrtf(a.friction * b.friction);
+
+    for (int i = 0; i < manifold.count; i++) {
+        ContactPoint& point = manifold.points[i];
+        Vec2 rA = point.position - a.position;
+        Vec2 rB = point.position - b.position;
+
+        Vec2 dv = b.velocity + cross(b.angularVelocity, rB) - a.velocity - cross(a.angularVelocity, rA);
+        float impulseNormal = point.massNormal * (-dot(dv, manifold.normal) + point.bias);
+        float oldNormal = point.normalImpulse;
+        point.normalImpulse = std::max(oldNormal + impulseNormal, 0.0f);
+        Vec2 impulse = manifold.normal * (point.normalImpulse - oldNormal);
+        a.velocity -= impulse * a.invMass;
+        a.angularVelocity -= a.invInertia * cross(rA, impulse);
+        b.velocity += impulse * b.invMass;
+        b.angularVelocity += b.invInertia * cross(rB, impulse);
+
+        dv = b.velocity + cross(b.angularVelocity, rB) - a.velocity - cross(a.angularVelocity, rA);
+        float impulseTangent = point.massTangent * -dot(dv, tangent);
+        float maxFriction = friction * point.normalImpulse;
+        float oldTangent = point.tangentImpulse;
+        point.tangentImpulse = std::max(-maxFriction, std::min(oldTangent + impulseTangent, maxFriction));
+        impulse = tangent * (point.tangentImpulse - oldTangent);
+        a.velocity -= impulse * a.invMass;
+        a.angularVelocity -= a.invInertia * cross(rA, impulse);
+        b.velocity += impulse * b.invMass;
+        b.angularVelocity += b.invInertia * cross(rB, impulse);
+    }
+}
+
+int PhysicsWorld::findIsland(int body) {
+    while (islandParent[body] != body) {
+        islandParent[body] = islandParent[islandParent[body]];
+        body = islandParent[body];
+    }
+    return body;
+}
+
+// Ostrvo (tela povezana kontaktima, bez statickih) spava tek kada su sva njegova tela mirna.
+// Svaki kontakt ima bar jedno budno telo, pa su oba dinamicka tela para u awakeBodies.
+void PhysicsWorld::updateSleep(float dt) {
+    islandParent.resize(bodies.size());
+    islandSleep.resize(bodies.size());
+    for (size_t k = 0; k < awakeBodies.size(); k++) {
+        islandParent[awakeBodies[k]] = awakeBodies[k];
+        islandSleep[awakeBodies[k]] = SLEEP_TIME * 2.0f;
+    }
+    for (size_t m = 0; m < manifolds.size(); m++) {
+        const Manifold& manifold = manifolds[m];
+        if (bodies[manifold.bodyA].isStatic() || bodies[manifold.bodyB].isStatic()) continue;
+        islandParent[findIsland(manifold.bodyA)] = findIsland(manifold.bodyB);
+    }
+
+    // Najkrace mirovanje po ostrvu (u korenu)
+    for (size_t k = 0; k < awakeBodies.size(); k++) {
+        RigidBody& body = bodies[awakeBodies[k]];
+        bool still = dot(body.velocity, body.velocity) < SLEEP_LINEAR_SPEED * SLEEP_LINEAR_SPEED
+            && fabsf(body.angularVelocity) < SLEEP_ANGULAR_SPEED;
+        body.sleepTime = still ? body.sleepTime + dt : 0.0f;
+        int island = findIsland(awakeBodies[k]);
+        islandSleep[island] = std::min(islandSleep[island], body.sleepTime);
+    }
+
+    for (size_t k = 0; k < awakeBodies.size(); k++) {
+        RigidBody& body = bodies[awakeBodies[k]];
+        if (islandSleep[findIsland(awakeBodies[k])] >= SLEEP_TIME) {
+            awakeCount--;
+            body.awake = false;
+            body.velocity = Vec2();
+            body.angularVelocity = 0.0f;
+        }
+    }
+}
+
+void PhysicsWorld::step(float dt) {
+    if (dt <= 0.0f || awakeCount == 0) return;
+    float inverseDt = 1.0f / dt;
+
+    collide();
+
+    for (size_t k = 0; k < awakeBodies.size(); k++) {
+        RigidBody& body = bodies[awakeBodies[k]];
+        body.velocity += gravity * (dt - body.consumedTime);
+    }
+
+    for (size_t m = 0; m < manifolds.size(); m++) {
+        preStep(manifolds[m], inverseDt);
+    }
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        for (size_t m = 0; m < manifolds.size(); m++) {
+            applyImpulse(manifolds[m]);
+        }
+    }
+
+    for (size_t k = 0; k < awakeBodies.size(); k++) {
+        RigidBody& body = bodies[awakeBodies[k]];
+        float bodyDt = dt - body.consumedTime;
+        body.position += body.velocity * bodyDt;
+        body.angle += body.angularVelocity * bodyDt;
+        body.consumedTime = 0.0f;
+    }
+
+    updateSleep(dt);
+}
+
+// step(t) bez kontakata: v(t) = v + g t, x(t) = x + v(t) t = x + v t + g t^2 - trenutak udara je
+// tacan za putanju integratora. Rotacija tokom koraka se zanemaruje (telo koje pada ne rotira).
+bool PhysicsWorld::advanceToImpact(int id, int target, float dt, float& timeOfImpact) {
+    RigidBody& body = bodies[id];
+    float remaining = dt - body.consumedTime;
+    if (remaining <= 0.0f || !body.active || body.isStatic() || !bodies[target].active) return false;
+    float time;
+    if (!sweepBoxes(body, body.velocity, gravity, remaining, bodies[target], time)) return false;
+
+    body.velocity += gravity * time;
+    body.position += body.velocity * time;
+    body.consumedTime += time;
+    timeOfImpact = body.consumedTime;
+    wake(id);
+    return true;
+}
+
+bool PhysicsWorld::hasContacts(int id) const {
+    for (size_t m = 0; m < manifolds.size(); m++) {
+        if (manifolds[m].bodyA == id || manifolds[m].bodyB == id) return true;
+    }
+    return false;
+}
+
+bool PhysicsWorld::isTouching(int a, int b) const {
+    for (size_t m = 0; m < manifolds.size(); m++) {
+        const Manifold& manifold = manifolds[m];
+        if ((manifold.bodyA == a && manifold.bodyB == b) || (manifold.bodyA == b && manifold.bodyB == a)) return true;
+    }
+    return false;
+}
+
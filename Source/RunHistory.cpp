@@ -0,0 +1,568 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../Header/RunHistory.h"
+#include "../Header/FileUtil.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+static const char BLOCK_MAGIC[4] = { 'K', 'R', 'U', 'N' };
+static const char TAIL_MAGIC[4] = { 'K', 'R', 'T', 'L' };
+static const uint32_t HISTORY_VERSION = 1;
+
+// Prepustanje i njihanje se cuvaju kao celi brojevi u ovim jedinicama
+static const float OVERHANG_SCALE = 10000.0f;
+static const float SWAY_SCALE = 100000.0f;
+
+namespace {
+    // Tail: magic | version | int64 duzina istorije kada je tail poceo | redovi fiksne duzine
+    const size_t TAIL_HEADER_SIZE = 16;
+    const size_t TAIL_ROW_DATA = 1 + ScoreRecord::MAX_NAME_LENGTH + 8 + 4 * 5;
+    const size_t TAIL_ROW_SIZE = TAIL_ROW_DATA + 4;
+
+    uint32_t fnv(const unsigned char* data, size_t length, uint32_t hash = 2166136261u) {
+        for (size_t i = 0; i < length; i++) {
+            hash = (hash ^ data[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+    bool seekTo(FILE* file, long long offset) {
+#ifdef _WIN32
+        return _fseeki64(file, offset, SEEK_SET) == 0;
+#else
+        return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+    }
+
+    long long sizeOf(FILE* file) {
+#ifdef _WIN32
+        if (_fseeki64(file, 0, SEEK_END) != 0) return -1;
+        return _ftelli64(file);
+#else
+        if (fseeko(file, 0, SEEK_END) != 0) return -1;
+        return static_cast<long long>(ftello(file));
+#endif
+    }
+
+    void putVarint(std::vector<unsigned char>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<unsigned char>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<unsigned char>(value));
+    }
+
+    bool getVarint(const unsigned char*& data, const unsigned char* end, uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && data < end; shift += 7) {
+            unsigned char byte = *data++;
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (byte < 0x80) return true;
+        }
+        return false;
+    }
+
+    uint64_t zigzag(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    int64_t unzigzag(uint64_t value) {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    uint64_t quantize(float value, float scale) {
+        if (!(value > 0.0f)) return 0;
+        return static_cast<uint64_t>(std::lround(value * scale));
+    }
+
+    void encodeTailRow(const RunRecord& run, unsigned char* row) {
+        unsigned char* out = row;
+        size_t length = strlen(run.name);
+        *out++ = static_cast<unsigned char>(length);
+        memset(out, 0, ScoreRecord::MAX_NAME_LENGTH);
+        memcpy(out, run.name, length);
+        out += ScoreRecord::MAX_NAME_LENGTH;
+        memcpy(out, &run.timestampMs, 8); out += 8;
+        memcpy(out, &run.score, 4); out += 4;
+        memcpy(out, &run.durationMs, 4); out += 4;
+        memcpy(out, &run.drops, 4); out += 4;
+        memcpy(out, &run.meanOverhang, 4); out += 4;
+        memcpy(out, &run.finalSwayAmplitude, 4); out += 4;
+        uint32_t checksum = fnv(row, TAIL_ROW_DATA);
+        memcpy(out, &checksum, 4);
+    }
+
+    bool decodeTailRow(const unsigned char* row, RunRecord& run) {
+        uint32_t checksum;
+        memcpy(&checksum, row + TAIL_ROW_DATA, 4);
+        if (checksum != fnv(row, TAIL_ROW_DATA) || row[0] > ScoreRecord::MAX_NAME_LENGTH) return false;
+
+        const unsigned char* in = row + 1;
+        memcpy(run.name, in, row[0]);
+        run.name[row[0]] = '\0';
+        in += ScoreRecord::MAX_NAME_LENGTH;
+        memcpy(&run.timestampMs, in, 8); in += 8;
+        memcpy(&run.score, in, 4); in += 4;
+        memcpy(&run.durationMs, in, 4); in += 4;
+        memcpy(&run.drops, in, 4); in += 4;
+        memcpy(&run.meanOverhang, in, 4); in += 4;
+        memcpy(&run.finalSwayAmplitude, in, 4);
+        return true;
+    }
+
+    // Ispravni redovi tail-a; baseOffset = duzina istorije kada je tail poceo (-1 ako nema zaglavlja)
+    void loadTail(const std::string& path, std::vector<RunRecord>& runs, long long& baseOffset) {
+        runs.clear();
+        baseOffset = -1;
+
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file) return;
+
+        unsigned char header[TAIL_HEADER_SIZE];
+        uint32_t version = 0;
+        if (fread(header, 1, sizeof(header), file) == sizeof(header) && memcmp(header, TAIL_MAGIC, 4) == 0) {
+            memcpy(&version, header + 4, 4);
+        }
+        if (version == HISTORY_VERSION) {
+            int64_t offset;
+            memcpy(&offset, header + 8, 8);
+            baseOffset = offset;
+
+            // Red koji nije ceo ili nema dobru kontrolnu sumu je prekinut upis - tu je kraj
+            unsigned char row[TAIL_ROW_SIZE];
+            RunRecord run;
+            while (fread(row, 1, TAIL_ROW_SIZE, file) == TAIL_ROW_SIZE && decodeTailRow(row, run)) {
+                runs.push_back(run);
+            }
+        }
+        fclose(file);
+    }
+
+    bool writeTailHeader(FILE* file, long long historyEnd) {
+        unsigned char header[TAIL_HEADER_SIZE];
+        int64_t offset = historyEnd;
+        memcpy(header, TAIL_MAGIC, 4);
+        memcpy(header + 4, &HISTORY_VERSION, 4);
+        memcpy(header + 8, &offset, 8);
+        return fwrite(header, 1, sizeof(header), file) == sizeof(header);
+    }
+
+    size_t payloadSize(const RunHistory::BlockHeader& header) {
+        size_t total = 0;
+        for (int c = 0; c < RunHistory::COLUMN_COUNT; c++) {
+            total += header.columnBytes[c];
+        }
+        return total;
+    }
+
+    // Zaglavlje bloka na position, ako je ispravno i ceo blok je u fajlu
+    bool readBlockHeader(FILE* file, long long position, long long fileSize, RunHistory::BlockHeader& header) {
+        if (position + static_cast<long long>(sizeof(header)) > fileSize) return false;
+        if (!seekTo(file, position) || fread(&header, sizeof(header), 1, file) != 1) return false;
+        if (memcmp(header.magic, BLOCK_MAGIC, 4) != 0 || header.version != HISTORY_VERSION) return false;
+        if (header.runCount == 0 || header.runCount > RunHistory::BLOCK_RUNS) return false;
+        return position + static_cast<long long>(sizeof(header) + payloadSize(header)) <= fileSize;
+    }
+
+    void encodeBlock(const std::vector<RunRecord>& runs, std::vector<unsigned char>& out) {
+        std::vector<unsigned char> columns[RunHistory::COLUMN_COUNT];
+        std::unordered_map<std::string, uint32_t> nameIndex;
+
+        RunHistory::BlockHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, BLOCK_MAGIC, 4);
+        header.version = HISTORY_VERSION;
+        header.runCount = static_cast<uint32_t>(runs.size());
+        header.minTimestampMs = runs[0].timestampMs;
+        header.maxTimestampMs = runs[0].timestampMs;
+        for (const RunRecord& run : runs) {
+            header.minTimestampMs = std::min<int64_t>(header.minTimestampMs, run.timestampMs);
+            header.maxTimestampMs = std::max<int64_t>(header.maxTimestampMs, run.timestampMs);
+        }
+
+        long long previousTimestamp = header.minTimestampMs;
+        for (const RunRecord& run : runs) {
+            std::string name(run.name);
+            auto inserted = nameIndex.emplace(name, static_cast<uint32_t>(nameIndex.size()));
+            if (inserted.second) {
+                putVarint(columns[RunHistory::COLUMN_NAMES], name.size());
+                columns[RunHistory::COLUMN_NAMES].insert(columns[RunHistory::COLUMN_NAMES].end(), name.begin(), name.end());
+            }
+            putVarint(columns[RunHistory::COLUMN_PLAYER], inserted.first->second);
+
+            putVarint(columns[RunHistory::COLUMN_TIMESTAMP], zigzag(run.timestampMs - previousTimestamp));
+            previousTimestamp = run.timestampMs;
+
+            putVarint(columns[RunHistory::COLUMN_SCORE], zigzag(run.score));
+            putVarint(columns[RunHistory::COLUMN_DURATION], static_cast<uint64_t>(std::max(run.durationMs, 0)));
+            putVarint(columns[RunHistory::COLUMN_DROPS], static_cast<uint64_t>(std::max(run.drops, 0)));
+            putVarint(columns[RunHistory::COLUMN_OVERHANG], quantize(run.meanOverhang, OVERHANG_SCALE));
+            putVarint(columns[RunHistory::COLUMN_SWAY], quantize(run.finalSwayAmplitude, SWAY_SCALE));
+        }
+
+        uint32_t checksum = 2166136261u;
+        for (int c = 0; c < RunHistory::COLUMN_COUNT; c++) {
+            header.columnBytes[c] = static_cast<uint32_t>(columns[c].size());
+            checksum = fnv(columns[c].data(), columns[c].size(), checksum);
+        }
+        header.checksum = checksum;
+
+        const unsigned char* headerBytes = reinterpret_cast<const unsigned char*>(&header);
+        out.assign(headerBytes, headerBytes + sizeof(header));
+        for (int c = 0; c < RunHistory::COLUMN_COUNT; c++) {
+            out.insert(out.end(), columns[c].begin(), columns[c].end());
+        }
+    }
+
+    // Dekodira samo trazene kolone; ostale se preskacu po duzini iz zaglavlja
+    bool decodeBlock(const RunHistory::BlockHeader& header, const std::vector<unsigned char>& payload, unsigned columns,
+        RunHistory::Block& block)
+    {
+        size_t count = header.runCount;
+        block.count = count;
+        block.minTimestampMs = header.minTimestampMs;
+        block.maxTimestampMs = header.maxTimestampMs;
+        if ((columns & (1u << RunHistory::COLUMN_PLAYER)) != 0) columns |= 1u << RunHistory::COLUMN_NAMES;
+
+        const unsigned char* column = payload.data();
+        uint64_t value;
+        for (int c = 0; c < RunHistory::COLUMN_COUNT; c++) {
+            const unsigned char* data = column;
+            const unsigned char* end = column + header.columnBytes[c];
+            column = end;
+            if ((columns & (1u << c)) == 0) continue;
+
+            switch (c) {
+            case RunHistory::COLUMN_NAMES:
+                block.names.clear();
+                while (data < end) {
+                    if (!getVarint(data, end, value) || value > static_cast<uint64_t>(end - data)) return false;
+                    block.names.push_back(std::string(reinterpret_cast<const char*>(data), static_cast<size_t>(value)));
+                    data += value;
+                }
+                break;
+            case RunHistory::COLUMN_PLAYER:
+                block.player.resize(count);
+                for (size_t i = 0; i < count; i++) {
+                    if (!getVarint(data, end, value) || value >= block.names.size()) return false;
+                    block.player[i] = static_cast<uint32_t>(value);
+                }
+                break;
+            case RunHistory::COLUMN_TIMESTAMP: {
+                block.timestampMs.resize(count);
+                long long timestamp = header.minTimestampMs;
+                for (size_t i = 0; i < count; i++) {
+                    if (!getVarint(data, end, value)) return false;
+                    timestamp += unzigzag(value);
+                    block.timestampMs[i] = timestamp;
+                }
+                break;
+            }
+            case RunHistory::COLUMN_SCORE:
+                block.score.resize(count);
+                for (size_t i = 0; i < count; i++) {
+                    if (!getVarint(data, end, value)) return false;
+                    block.score[i] = static_cast<int>(unzigzag(value));
+                }
+                break;
+            case RunHistory::COLUMN_DURATION:
+            case RunHistory::COLUMN_DROPS: {
+                std::vector<int>& target = c == RunHistory::COLUMN_DURATION ? block.durationMs : block.drops;
+                target.resize(count);
+                for (size_t i = 0; i < count; i++) {
+                    if (!getVarint(data, end, value)) return false;
+                    target[i] = static_cast<int>(value);
+                }
+                break;
+            }
+            case RunHistory::COLUMN_OVERHANG:
+            case RunHistory::COLUMN_SWAY: {
+                std::vector<float>& target = c == RunHistory::COLUMN_OVERHANG ? block.meanOverhang : block.finalSwayAmplitude;
+                float scale = c == RunHistory::COLUMN_OVERHANG ? OVERHANG_SCALE : SWAY_SCALE;
+                target.resize(count);
+                for (size_t i = 0; i < count; i++) {
+                    if (!getVarint(data, end, value)) return false;
+                    target[i] = static_cast<float>(value) / scale;
+                }
+                break;
+            }
+            }
+        }
+        return true;
+    }
+
+    // Partije iz tail-a kao blok (iste kolone kao dekodiran blok)
+    void blockFromRuns(const std::vector<RunRecord>& runs, unsigned columns, RunHistory::Block& block) {
+        block.count = runs.size();
+        block.minTimestampMs = LLONG_MAX;
+        block.maxTimestampMs = LLONG_MIN;
+        block.names.clear();
+        block.player.clear();
+        block.timestampMs.clear();
+        block.score.clear();
+        block.durationMs.clear();
+        block.drops.clear();
+        block.meanOverhang.clear();
+        block.finalSwayAmplitude.clear();
+
+        bool players = (columns & ((1u << RunHistory::COLUMN_PLAYER) | (1u << RunHistory::COLUMN_NAMES))) != 0;
+        std::unordered_map<std::string, uint32_t> nameIndex;
+        for (const RunRecord& run : runs) {
+            block.minTimestampMs = std::min(block.minTimestampMs, run.timestampMs);
+            block.maxTimestampMs = std::max(block.maxTimestampMs, run.timestampMs);
+            if (players) {
+                auto inserted = nameIndex.emplace(run.name, static_cast<uint32_t>(block.names.size()));
+                if (inserted.second) block.names.push_back(run.name);
+                block.player.push_back(inserted.first->second);
+            }
+            if (columns & (1u << RunHistory::COLUMN_TIMESTAMP)) block.timestampMs.push_back(run.timestampMs);
+            if (columns & (1u << RunHistory::COLUMN_SCORE)) block.score.push_back(run.score);
+            if (columns & (1u << RunHistory::COLUMN_DURATION)) block.durationMs.push_back(run.durationMs);
+            if (columns & (1u << RunHistory::COLUMN_DROPS)) block.drops.push_back(run.drops);
+            if (columns & (1u << RunHistory::COLUMN_OVERHANG)) block.meanOverhang.push_back(run.meanOverhang);
+            if (columns & (1u << RunHistory::COLUMN_SWAY)) block.finalSwayAmplitude.push_back(run.finalSwayAmplitude);
+        }
+    }
+}
+
+RunHistory::~RunHistory() {
+    close();
+}
+
+bool RunHistory::open(const std::string& path) {
+    close();
+    historyPath = path;
+    tailPath = path + ".tail";
+
+    history = fopen(path.c_str(), "r+b");
+    if (!history) history = fopen(path.c_str(), "w+b");
+    if (!history) {
+        std::cerr << "Ne mogu da otvorim istoriju partija: " << path << std::endl;
+        return false;
+    }
+
+    // Blokovi se samo nadovezuju, pa prekinut upis moze biti samo poslednji blok
+    long long fileSize = sizeOf(history);
+    long long position = 0;
+    long long lastBlock = -1;
+    BlockHeader header;
+    while (readBlockHeader(history, position, fileSize, header)) {
+        lastBlock = position;
+        position += sizeof(header) + payloadSize(header);
+    }
+    if (lastBlock >= 0) {
+        readBlockHeader(history, lastBlock, fileSize, header);
+        std::vector<unsigned char> payload(payloadSize(header));
+        if (fread(payload.data(), 1, payload.size(), history) != payload.size() ||
+            fnv(payload.data(), payload.size()) != header.checksum) {
+            position = lastBlock;
+        }
+    }
+    historyEnd = position;
+    if (fileSize > historyEnd) {
+        std::cerr << "Istorija partija: odbacen prekinut upis (" << (fileSize - historyEnd) << " B)" << std::endl;
+        truncateFile(history, historyEnd);
+    }
+
+    // Tail koji je poceo pre poslednjeg bloka je vec upisan u taj blok
+    long long baseOffset;
+    loadTail(tailPath, tailRuns, baseOffset);
+    if (baseOffset < historyEnd) tailRuns.clear();
+
+    if (tailRuns.size() >= BLOCK_RUNS) return sealBlock();
+
+    // Tail se prepisuje sa ispravnim redovima i novom pocetnom duzinom
+    std::string tempPath = tailPath + ".tmp";
+    FILE* temp = fopen(tempPath.c_str(), "wb");
+    if (!temp) {
+        std::cerr << "Ne mogu da upisem fajl: " << tempPath << std::endl;
+        return false;
+    }
+    bool ok = writeTailHeader(temp, historyEnd);
+    unsigned char row[TAIL_ROW_SIZE];
+    for (const RunRecord& run : tailRuns) {
+        encodeTailRow(run, row);
+        if (fwrite(row, 1, sizeof(row), temp) != sizeof(row)) ok = false;
+    }
+    syncFile(temp);
+    if (fclose(temp) != 0) ok = false;
+    if (!ok || !replaceFile(tempPath, tailPath)) {
+        std::cerr << "Ne mogu da upisem fajl: " << tailPath << std::endl;
+        remove(tempPath.c_str());
+        return false;
+    }
+
+    tail = fopen(tailPath.c_str(), "ab");
+    return tail != nullptr;
+}
+
+void RunHistory::close() {
+    if (tail) {
+        fclose(tail);
+        tail = nullptr;
+    }
+    if (history) {
+        fclose(history);
+        history = nullptr;
+    }
+    tailRuns.clear();
+}
+
+bool RunHistory::resetTail() {
+    if (tail) fclose(tail);
+    tail = fopen(tailPath.c_str(), "wb");
+    if (!tail) {
+        std::cerr << "Ne mogu da upisem fajl: " << tailPath << std::endl;
+        return false;
+    }
+
+    bool ok = writeTailHeader(tail, historyEnd);
+    syncFile(tail);
+    return ok;
+}
+
+// Redosled: blok na disk (fsync), pa nov prazan tail - prekid izmedju ostavlja tail koji se odbacuje
+bool RunHistory::sealBlock() {
+    std::vector<unsigned char> block;
+    encodeBlock(tailRuns, block);
+
+    if (!seekTo(history, historyEnd) || fwrite(block.data(), 1, block.size(), history) != block.size()) {
+        std::cerr << "Ne mogu da upisem istoriju partija: " << historyPath << std::endl;
+        return false;
+    }
+    syncFile(history);
+
+    historyEnd += static_cast<long long>(block.size());
+    tailRuns.clear();
+    return resetTail();
+}
+
+bool RunHistory::append(const RunRecord& run) {
+    if (!tail) return false;
+
+    unsigned char row[TAIL_ROW_SIZE];
+    encodeTailRow(run, row);
+    if (fwrite(row, 1, sizeof(row), tail) != sizeof(row)) return false;
+
+    tailRuns.push_back(run);
+    if (tailRuns.size() >= BLOCK_RUNS) return sealBlock();
+    return true;
+}
+
+bool RunHistory::flush(bool sync) {
+    if (!tail) return false;
+    if (sync) {
+        syncFile(tail);
+        return true;
+    }
+    return fflush(tail) == 0;
+}
+
+RunHistoryReader::~RunHistoryReader() {
+    close();
+}
+
+bool RunHistoryReader::open(const std::string& path) {
+    close();
+    file = fopen(path.c_str(), "rb");
+    if (!file) {
+        std::cerr << "Ne mogu da otvorim istoriju partija: " << path << std::endl;
+        return false;
+    }
+    tailPath = path + ".tail";
+    position = 0;
+    fileSize = sizeOf(file);
+    blocksDone = false;
+    tailDone = false;
+    return true;
+}
+
+void RunHistoryReader::close() {
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+    blocksDone = tailDone = true;
+}
+
+bool RunHistoryReader::next(RunHistory::Block& block, unsigned columns, long long sinceMs) {
+    RunHistory::BlockHeader header;
+    while (!blocksDone) {
+        if (!readBlockHeader(file, position, fileSize, header)) {
+            blocksDone = true;
+            break;
+        }
+
+        long long blockStart = position;
+        position += sizeof(header) + payloadSize(header);
+        if (header.maxTimestampMs < sinceMs) continue;   // Ceo blok je stariji - ne cita se
+
+        payload.resize(payloadSize(header));
+        if (fread(payload.data(), 1, payload.size(), file) != payload.size() ||
+            fnv(payload.data(), payload.size()) != header.checksum || !decodeBlock(header, payload, columns, block)) {
+            // Prekinut poslednji blok - tail koji je poceo ovde jos vazi
+            position = blockStart;
+            blocksDone = true;
+            break;
+        }
+        return true;
+    }
+
+    if (!tailDone) {
+        tailDone = true;
+
+        std::vector<RunRecord> runs;
+        long long baseOffset;
+        loadTail(tailPath, runs, baseOffset);
+        if (baseOffset >= position && !runs.empty()) {
+            blockFromRuns(runs, columns, block);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool bestScoresSince(const std::string& historyPath, long long sinceMs, std::vector<std::pair<std::string, int> >& best) {
+    best.clear();
+    RunHistoryReader reader;
+    if (!reader.open(historyPath)) return false;
+
+    const unsigned columns = (1u << RunHistory::COLUMN_PLAYER) | (1u << RunHistory::COLUMN_TIMESTAMP) | (1u << RunHistory::COLUMN_SCORE);
+    RunHistory::Block block;
+    std::vector<int> filtered;
+    std::vector<int> blockBest;
+    std::unordered_map<std::string, int> bestByName;
+
+    while (reader.next(block, columns, sinceMs)) {
+        size_t count = block.count;
+
+        // Filter po vremenu bez grananja nad celom kolonom (kompajler ga vektorizuje)
+        filtered.resize(count);
+        const long long* timestamps = block.timestampMs.data();
+        const int* scores = block.score.data();
+        int* out = filtered.data();
+        for (size_t i = 0; i < count; i++) {
+            out[i] = timestamps[i] >= sinceMs ? scores[i] : INT_MIN;
+        }
+
+        // Najbolji po indeksu imena u bloku, pa tek onda po imenu (jedna pretraga po igracu bloka)
+        blockBest.assign(block.names.size(), INT_MIN);
+        const uint32_t* players = block.player.data();
+        for (size_t i = 0; i < count; i++) {
+            blockBest[players[i]] = std::max(blockBest[players[i]], out[i]);
+        }
+        for (size_t p = 0; p < block.names.size(); p++) {
+            if (blockBest[p] == INT_MIN || block.names[p].empty()) continue;
+            auto inserted = bestByName.emplace(block.names[p], blockBest[p]);
+            if (!inserted.second) inserted.first->second = std::max(inserted.first->second, blockBest[p]);
+        }
+    }
+
+    best.assign(bestByName.begin(), bestByName.end());
+    std::sort(best.begin(), best.end(), [](const std::pair<std::string, int>& a, const std::pair<std::string, int>& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    return true;
+}
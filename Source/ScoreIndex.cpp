@@ -0,0 +1,313 @@
+#include "../Header/ScoreIndex.h"
+#include <cstring>
+
+ScoreIndex::ScoreIndex()
+    : root(nullptr), firstLeaf(nullptr), count(0), nextSequence(0)
+{
+    firstLeaf = newLeaf();
+    root = firstLeaf;
+}
+
+ScoreIndex::~ScoreIndex() {
+    freeTree(root);
+}
+
+bool ScoreIndex::before(const Key& a, const Key& b) {
+    if (a.score != b.score) return a.score > b.score;
+    return a.sequence < b.sequence;
+}
+
+// Prvo dete ciji maxKey nije ispred kljuca (binarna pretraga); inace poslednje dete
+int ScoreIndex::findChild(const Inner* inner, const Key& key) {
+    int low = 0;
+    int high = inner->count - 1;
+    while (low < high) {
+        int middle = (low + high) / 2;
+        if (before(inner->maxKeys[middle], key)) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+ScoreIndex::Leaf* ScoreIndex::newLeaf() {
+    Leaf* leaf = new Leaf;
+    leaf->leaf = true;
+    leaf->count = 0;
+    leaf->previous = nullptr;
+    leaf->next = nullptr;
+    return leaf;
+}
+
+void ScoreIndex::freeTree(Node* node) {
+    if (node->leaf) {
+        delete static_cast<Leaf*>(node);
+        return;
+    }
+    Inner* inner = static_cast<Inner*>(node);
+    for (int i = 0; i < inner->count; i++) {
+        freeTree(inner->children[i]);
+    }
+    delete inner;
+}
+
+namespace {
+    // Pomocne funkcije nad cvorovima (bez pristupa stanju indeksa)
+    template <typename LeafType, typename KeyType, typename Less>
+    int leafLowerBound(const LeafType* leaf, const KeyType& key, Less less) {
+        int low = 0;
+        int high = leaf->count;
+        while (low < high) {
+            int middle = (low + high) / 2;
+            if (less(leaf->entries[middle].key, key)) {
+                low = middle + 1;
+            }
+            else {
+                high = middle;
+            }
+        }
+        return low;
+    }
+}
+
+// Vraca novi desni cvor ako je cvor podeljen; splitMaxKey/splitSize opisuju levi (postojeci) cvor
+ScoreIndex::Node* ScoreIndex::insertInto(Node* node, const Entry& entry, Key& splitMaxKey, uint32_t& splitSize) {
+    if (node->leaf) {
+        Leaf* leaf = static_cast<Leaf*>(node);
+        Leaf* target = leaf;
+        Leaf* right = nullptr;
+
+        if (leaf->count == LEAF_CAPACITY) {
+            // Podela lista na pola
+            right = newLeaf();
+            int half = LEAF_CAPACITY / 2;
+            right->count = LEAF_CAPACITY - half;
+            memcpy(right->entries, leaf->entries + half, right->count * sizeof(Entry));
+            leaf->count = half;
+
+            right->next = leaf->next;
+            right->previous = leaf;
+            if (leaf->next) leaf->next->previous = right;
+            leaf->next = right;
+
+            if (!before(entry.key, right->entries[0].key)) target = right;
+        }
+
+        int position = leafLowerBound(target, entry.key, before);
+        memmove(target->entries + position + 1, target->entries + position, (target->count - position) * sizeof(Entry));
+        target->entries[position] = entry;
+        target->count++;
+
+        if (right) {
+            splitMaxKey = leaf->entries[leaf->count - 1].key;
+            splitSize = static_cast<uint32_t>(leaf->count);
+        }
+        return right;
+    }
+
+    Inner* inner = static_cast<Inner*>(node);
+    int index = findChild(inner, entry.key);
+    if (before(inner->maxKeys[index], entry.key)) {
+        inner->maxKeys[index] = entry.key;   // Novi najveci kljuc (samo poslednje dete)
+    }
+    inner->sizes[index]++;
+
+    Key childMaxKey;
+    uint32_t childSize;
+    Node* sibling = insertInto(inner->children[index], entry, childMaxKey, childSize);
+    if (!sibling) return nullptr;
+
+    // Dete je podeljeno - desna polovina ide odmah iza njega
+    int moved = inner->count - index - 1;
+    memmove(inner->maxKeys + index + 2, inner->maxKeys + index + 1, moved * sizeof(Key));
+    memmove(inner->sizes + index + 2, inner->sizes + index + 1, moved * sizeof(uint32_t));
+    memmove(inner->children + index + 2, inner->children + index + 1, moved * sizeof(Node*));
+
+    inner->maxKeys[index + 1] = inner->maxKeys[index];
+    inner->sizes[index + 1] = inner->sizes[index] - childSize;
+    inner->children[index + 1] = sibling;
+    inner->maxKeys[index] = childMaxKey;
+    inner->sizes[index] = childSize;
+    inner->count++;
+
+    if (inner->count < INNER_CAPACITY) return nullptr;
+
+    // Pun unutrasnji cvor - podela na pola
+    Inner* right = new Inner;
+    right->leaf = false;
+    int half = INNER_CAPACITY / 2;
+    right->count = inner->count - half;
+    memcpy(right->maxKeys, inner->maxKeys + half, right->count * sizeof(Key));
+    memcpy(right->sizes, inner->sizes + half, right->count * sizeof(uint32_t));
+    memcpy(right->children, inner->children + half, right->count * sizeof(Node*));
+    inner->count = half;
+
+    splitMaxKey = inner->maxKeys[half - 1];
+    splitSize = 0;
+    for (int i = 0; i < half; i++) {
+        splitSize += inner->sizes[i];
+    }
+    return right;
+}
+
+void ScoreIndex::unlinkLeaf(Leaf* leaf) {
+    if (leaf->previous) leaf->previous->next = leaf->next;
+    if (leaf->next) leaf->next->previous = leaf->previous;
+    if (firstLeaf == leaf) firstLeaf = leaf->next;
+}
+
+bool ScoreIndex::eraseFrom(Node* node, const Key& key) {
+    if (node->leaf) {
+        Leaf* leaf = static_cast<Leaf*>(node);
+        int position = leafLowerBound(leaf, key, before);
+        if (position == leaf->count || before(key, leaf->entries[position].key)) return false;
+
+        memmove(leaf->entries + position, leaf->entries + position + 1, (leaf->count - position - 1) * sizeof(Entry));
+        leaf->count--;
+        return true;
+    }
+
+    Inner* inner = static_cast<Inner*>(node);
+    int index = findChild(inner, key);
+    Node* child = inner->children[index];
+    if (!eraseFrom(child, key)) return false;
+
+    inner->sizes[index]--;
+    if (child->count == 0) {
+        // Prazno dete se uklanja (bez spajanja delimicno popunjenih cvorova)
+        if (child->leaf) {
+            unlinkLeaf(static_cast<Leaf*>(child));
+            delete static_cast<Leaf*>(child);
+        }
+        else {
+            delete static_cast<Inner*>(child);
+        }
+
+        int moved = inner->count - index - 1;
+        memmove(inner->maxKeys + index, inner->maxKeys + index + 1, moved * sizeof(Key));
+        memmove(inner->sizes + index, inner->sizes + index + 1, moved * sizeof(uint32_t));
+        memmove(inner->children + index, inner->children + index + 1, moved * sizeof(Node*));
+        inner->count--;
+    }
+    return true;
+}
+
+void ScoreIndex::insertEntry(const Entry& entry) {
+    Key splitMaxKey;
+    uint32_t splitSize;
+    Node* sibling = insertInto(root, entry, splitMaxKey, splitSize);
+    count++;
+
+    if (sibling) {
+        // Novi koren sa dva deteta
+        Inner* newRoot = new Inner;
+        newRoot->leaf = false;
+        newRoot->count = 2;
+        newRoot->children[0] = root;
+        newRoot->maxKeys[0] = splitMaxKey;
+        newRoot->sizes[0] = splitSize;
+        newRoot->children[1] = sibling;
+        newRoot->sizes[1] = static_cast<uint32_t>(count) - splitSize;
+        if (sibling->leaf) {
+            Leaf* leaf = static_cast<Leaf*>(sibling);
+            newRoot->maxKeys[1] = leaf->entries[leaf->count - 1].key;
+        }
+        else {
+            Inner* inner = static_cast<Inner*>(sibling);
+            newRoot->maxKeys[1] = inner->maxKeys[inner->count - 1];
+        }
+        root = newRoot;
+    }
+}
+
+void ScoreIndex::eraseKey(const Key& key) {
+    if (!eraseFrom(root, key)) return;
+    count--;
+
+    // Skrati stablo dok koren ima samo jedno dete
+    while (!root->leaf && root->count <= 1) {
+        Inner* oldRoot = static_cast<Inner*>(root);
+        if (oldRoot->count == 0) {
+            firstLeaf = newLeaf();
+            root = firstLeaf;
+        }
+        else {
+            root = oldRoot->children[0];
+        }
+        delete oldRoot;
+    }
+}
+
+size_t ScoreIndex::rankOf(const Key& key) const {
+    size_t rank = 0;
+    const Node* node = root;
+    while (!node->leaf) {
+        const Inner* inner = static_cast<const Inner*>(node);
+        int index = findChild(inner, key);
+        for (int i = 0; i < index; i++) {
+            rank += inner->sizes[i];
+        }
+        node = inner->children[index];
+    }
+    return rank + leafLowerBound(static_cast<const Leaf*>(node), key, before);
+}
+
+void ScoreIndex::set(const std::string& name, int score) {
+    auto it = byName.find(name);
+    if (it != byName.end()) {
+        if (it->second.score == score) return;
+
+        // Igrac zadrzava redni broj prvog upisa
+        eraseKey(it->second);
+        it->second.score = score;
+    }
+    else {
+        Key key = { score, nextSequence++ };
+        it = byName.emplace(name, key).first;
+    }
+
+    Entry entry = { it->second, &it->first };
+    insertEntry(entry);
+}
+
+bool ScoreIndex::erase(const std::string& name) {
+    auto it = byName.find(name);
+    if (it == byName.end()) return false;
+
+    eraseKey(it->second);
+    byName.erase(it);
+    return true;
+}
+
+bool ScoreIndex::get(const std::string& name, int& score) const {
+    auto it = byName.find(name);
+    if (it == byName.end()) return false;
+
+    score = it->second.score;
+    return true;
+}
+
+void ScoreIndex::clear() {
+    freeTree(root);
+    firstLeaf = newLeaf();
+    root = firstLeaf;
+    count = 0;
+    nextSequence = 0;
+    byName.clear();
+}
+
+long long ScoreIndex::rank(const std::string& name) const {
+    auto it = byName.find(name);
+    if (it == byName.end()) return -1;
+    return static_cast<long long>(rankOf(it->second));
+}
+
+double ScoreIndex::percentile(const std::string& name) const {
+    long long position = rank(name);
+    if (position < 0) return -1.0;
+    if (count <= 1) return 100.0;
+    return 100.0 * static_cast<double>(count - 1 - position) / static_cast<double>(count - 1);
+}
@@ -0,0 +1,197 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../Header/ScoreJournal.h"
+#include "../Header/FileUtil.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+
+namespace {
+    // FNV-1a nad "score,timestamp,ime" - prepoznaje pokvarenu (delimicno upisanu) liniju
+    uint32_t recordChecksum(int score, long long timestampMs, const char* name) {
+        char prefix[48];
+        int length = snprintf(prefix, sizeof(prefix), "%d,%lld,", score, timestampMs);
+
+        uint32_t hash = 2166136261u;
+        for (int i = 0; i < length; i++) {
+            hash = (hash ^ static_cast<unsigned char>(prefix[i])) * 16777619u;
+        }
+        for (const char* c = name; *c; c++) {
+            hash = (hash ^ static_cast<unsigned char>(*c)) * 16777619u;
+        }
+        return hash;
+    }
+
+    bool parseRecord(const std::string& line, ScoreRecord& record) {
+        const char* text = line.c_str();
+        char* end = nullptr;
+
+        long score = strtol(text, &end, 10);
+        if (end == text || *end != ',') return false;
+        text = end + 1;
+
+        long long timestampMs = strtoll(text, &end, 10);
+        if (end == text || *end != ',') return false;
+        text = end + 1;
+
+        unsigned long checksum = strtoul(text, &end, 16);
+        if (end == text || *end != ',') return false;
+        text = end + 1;
+
+        size_t nameLength = strlen(text);
+        if (nameLength == 0 || nameLength > ScoreRecord::MAX_NAME_LENGTH) return false;
+        if (recordChecksum(static_cast<int>(score), timestampMs, text) != static_cast<uint32_t>(checksum)) return false;
+
+        memcpy(record.name, text, nameLength + 1);
+        record.score = static_cast<int>(score);
+        record.timestampMs = timestampMs;
+        return true;
+    }
+
+    // visitor(const ScoreRecord&) za svaki ispravan zapis; vraca broj zapisa
+    template <typename Visitor>
+    size_t replayFile(const std::string& path, Visitor visitor) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return 0;
+
+        size_t records = 0;
+        size_t skipped = 0;
+        std::string line;
+        ScoreRecord record;
+        while (std::getline(file, line)) {
+            // Linija bez '\n' na kraju fajla je prekinut upis
+            if (file.eof() || !parseRecord(line, record)) {
+                if (!line.empty()) skipped++;
+                continue;
+            }
+            visitor(record);
+            records++;
+        }
+
+        // Kompakcija na serveru ide stalno, pa se javljaju samo neispravni zapisi
+        if (skipped > 0) {
+            std::cout << "Dnevnik " << path << ": preskoceno neispravnih zapisa: " << skipped << std::endl;
+        }
+        return records;
+    }
+}
+
+std::string journalPathForStore(const std::string& storePath) {
+    size_t dot = storePath.find_last_of('.');
+    size_t separator = storePath.find_last_of("/\\");
+    if (dot == std::string::npos || (separator != std::string::npos && dot < separator)) return storePath + ".journal";
+    return storePath.substr(0, dot) + ".journal";
+}
+
+ScoreJournal::ScoreJournal(ScoreStore& snapshot, const std::string& journalFile, size_t threshold)
+    : store(snapshot), journalPath(journalFile), compactingPath(journalFile + ".old"), journal(nullptr),
+    journalRecords(0), compactionThreshold(threshold), pendingCompaction(false)
+{
+}
+
+ScoreJournal::~ScoreJournal() {
+    if (journal) {
+        fclose(journal);
+    }
+}
+
+bool ScoreJournal::openJournal() {
+    journal = fopen(journalPath.c_str(), "ab+");
+    if (!journal) {
+        std::cerr << "Ne mogu da otvorim dnevnik: " << journalPath << std::endl;
+        return false;
+    }
+
+    // Ako je poslednja linija prekinuta pri padu, zavrsi je - sledeci zapis pocinje u novom redu
+    if (fseek(journal, -1, SEEK_END) == 0) {
+        int last = fgetc(journal);
+        fseek(journal, 0, SEEK_END);
+        if (last != '\n') {
+            fputc('\n', journal);
+            fflush(journal);
+        }
+    }
+    return true;
+}
+
+void ScoreJournal::replay(Leaderboard& leaderboard) {
+    if (journal) {
+        fclose(journal);
+        journal = nullptr;
+    }
+
+    auto submit = [&leaderboard](const ScoreRecord& record) {
+        leaderboard.submit(record.name, record.score);
+    };
+
+    // Dnevnik prekinute kompakcije je stariji od aktivnog
+    if (fileExists(compactingPath)) {
+        size_t records = replayFile(compactingPath, submit);
+        std::cout << "Dnevnik " << compactingPath << ": " << records << " zapisa" << std::endl;
+        pendingCompaction = true;
+    }
+    journalRecords = replayFile(journalPath, submit);
+    std::cout << "Dnevnik " << journalPath << ": " << journalRecords << " zapisa" << std::endl;
+    openJournal();
+}
+
+bool ScoreJournal::append(const ScoreRecord& record) {
+    if (!journal && !openJournal()) return false;
+
+    uint32_t checksum = recordChecksum(record.score, record.timestampMs, record.name);
+
+    // Jedna linija na kraj fajla - bez citanja i prepisivanja ostatka
+    if (fprintf(journal, "%d,%lld,%08x,%s\n", record.score, record.timestampMs, checksum, record.name) < 0) {
+        std::cerr << "Ne mogu da upisem u dnevnik: " << journalPath << std::endl;
+        return false;
+    }
+    journalRecords++;
+    return true;
+}
+
+bool ScoreJournal::flush(bool sync) {
+    if (!journal) return false;
+
+    if (sync) {
+        syncFile(journal);
+    }
+    else if (fflush(journal) != 0) {
+        std::cerr << "Ne mogu da upisem u dnevnik: " << journalPath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ScoreJournal::compact() {
+    // Ako ".old" vec postoji (prekinuta kompakcija), ne sme se pregaziti - samo se ponovo spaja
+    if (!fileExists(compactingPath)) {
+        if (journal) {
+            syncFile(journal);
+            fclose(journal);
+            journal = nullptr;
+        }
+        if (rename(journalPath.c_str(), compactingPath.c_str()) != 0) {
+            std::cerr << "Ne mogu da preimenujem dnevnik: " << journalPath << std::endl;
+            openJournal();
+            return false;
+        }
+        journalRecords = 0;
+        openJournal();
+    }
+
+    // Zapisi iz ".old" idu u snapshot redom, pa vazi poslednji rezultat
+    bool stored = true;
+    replayFile(compactingPath, [this, &stored](const ScoreRecord& record) {
+        if (!store.upsert(record.name, record.score, record.timestampMs)) stored = false;
+    });
+    if (!stored || !store.flush(true)) {
+        std::cerr << "Ne mogu da upisem snapshot rezultata" << std::endl;
+        pendingCompaction = true;
+        return false;
+    }
+
+    remove(compactingPath.c_str());
+    pendingCompaction = false;
+    return true;
+}
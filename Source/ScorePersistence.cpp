@@ -0,0 +1,149 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../Header/ScorePersistence.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+// Najduze cekanje radnika ako se budjenje propusti
+static const std::chrono::milliseconds WAKE_TIMEOUT(100);
+// Posle neuspele kompakcije sledeci pokusaj ceka, pa se cekanje duplira do maksimuma
+static const std::chrono::milliseconds COMPACTION_RETRY_MIN(1000);
+static const std::chrono::milliseconds COMPACTION_RETRY_MAX(60000);
+
+ScorePersistence::ScorePersistence(const std::string& storeFile, const std::string& csvFile, const std::string& journalPath,
+    FsyncPolicy policy, int fsyncIntervalMs, const std::string& historyFile)
+    : storePath(storeFile), csvImportPath(csvFile), journal(store, journalPath), runHistoryPath(historyFile),
+    fsyncPolicy(policy), fsyncInterval(fsyncIntervalMs), stopping(false)
+{
+}
+
+ScorePersistence::~ScorePersistence() {
+    shutdown();
+}
+
+void ScorePersistence::start(Leaderboard& leaderboard) {
+    store.open(storePath, csvImportPath);
+    leaderboard.load(store);
+    journal.replay(leaderboard);
+    if (!runHistoryPath.empty()) runHistory.open(runHistoryPath);
+    worker = std::thread(&ScorePersistence::workerLoop, this);
+}
+
+bool ScorePersistence::submit(const std::string& name, int score) {
+    ScoreRecord record;
+    strncpy(record.name, name.c_str(), ScoreRecord::MAX_NAME_LENGTH);
+    record.name[ScoreRecord::MAX_NAME_LENGTH] = '\0';
+    record.score = score;
+    record.timestampMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    if (!submit(record)) {
+        std::cerr << "Red za upis rezultata je pun, rezultat nije sacuvan: " << name << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ScorePersistence::submit(const ScoreRecord& record) {
+    if (!queue.tryPush(record)) return false;
+    wake.notify_one();
+    return true;
+}
+
+void ScorePersistence::waitForSpace() {
+    wake.notify_one();
+    std::unique_lock<std::mutex> lock(spaceMutex);
+    spaceAvailable.wait_for(lock, WAKE_TIMEOUT, [this]() {
+        return stopping.load() || !queue.full();
+    });
+}
+
+bool ScorePersistence::submitRun(const RunRecord& run) {
+    if (!runQueue.tryPush(run)) {
+        std::cerr << "Red za istoriju partija je pun, partija nije sacuvana" << std::endl;
+        return false;
+    }
+    wake.notify_one();
+    return true;
+}
+
+void ScorePersistence::workerLoop() {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point lastSync = Clock::now();
+    bool unsynced = false;
+    Clock::time_point compactionRetryAt = Clock::now();
+    std::chrono::milliseconds compactionBackoff = COMPACTION_RETRY_MIN;
+
+    while (true) {
+        // Procitaj pre praznjenja - sve sto je ubaceno pre shutdown() ce biti upisano
+        bool stop = stopping.load();
+
+        size_t written = 0;
+        ScoreRecord record;
+        while (queue.tryPop(record)) {
+            journal.append(record);
+            written++;
+        }
+        if (written > 0) {
+            // Zakljucavanje pre obavestenja: proizvodjac ne moze da propusti budjenje izmedju provere i cekanja
+            { std::lock_guard<std::mutex> lock(spaceMutex); }
+            spaceAvailable.notify_all();
+        }
+
+        RunRecord run;
+        size_t runsWritten = 0;
+        while (runQueue.tryPop(run)) {
+            runHistory.append(run);
+            runsWritten++;
+        }
+        if (runsWritten > 0) {
+            runHistory.flush(fsyncPolicy != FSYNC_NEVER);
+        }
+
+        if (written > 0) {
+            bool sync = fsyncPolicy == FSYNC_BATCH;
+            journal.flush(sync);
+            unsynced = !sync;
+            if (sync) lastSync = Clock::now();
+        }
+        if (unsynced && fsyncPolicy == FSYNC_INTERVAL && Clock::now() - lastSync >= fsyncInterval) {
+            journal.flush(true);
+            unsynced = false;
+            lastSync = Clock::now();
+        }
+
+        if (journal.needsCompaction() && Clock::now() >= compactionRetryAt) {
+            if (journal.compact()) {
+                compactionBackoff = COMPACTION_RETRY_MIN;
+            }
+            else {
+                compactionRetryAt = Clock::now() + compactionBackoff;
+                compactionBackoff = std::min(compactionBackoff * 2, COMPACTION_RETRY_MAX);
+            }
+        }
+
+        if (stop) break;
+
+        // submit() budi bez zakljucavanja, pa budjenje moze da se propusti - zato timeout
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait_for(lock, WAKE_TIMEOUT, [this]() {
+            return stopping.load() || !queue.empty() || !runQueue.empty();
+        });
+    }
+
+    if (unsynced && fsyncPolicy != FSYNC_NEVER) {
+        journal.flush(true);
+    }
+}
+
+void ScorePersistence::shutdown() {
+    if (!worker.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping.store(true);
+    }
+    wake.notify_all();
+    worker.join();
+    std::cout << "Upis rezultata zavrsen" << std::endl;
+}
@@ -0,0 +1,262 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../Header/ScoreStore.h"
+#include "../Header/CsvReader.h"
+#include "../Header/FileUtil.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <xmmintrin.h>
+#define PREFETCH(address) _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#else
+#define PREFETCH(address) __builtin_prefetch(address)
+#endif
+
+static const char STORE_MAGIC[4] = { 'K', 'S', 'C', 'R' };
+static const size_t PREFETCH_DISTANCE = 16;
+
+size_t ScoreStore::fileSize(uint32_t recordCapacity) {
+    return sizeof(StoreHeader) + recordCapacity * sizeof(StoreRecord) + 2 * recordCapacity * sizeof(uint32_t);
+}
+
+// FNV-1a
+uint32_t ScoreStore::hashName(const char* name, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ static_cast<unsigned char>(name[i])) * 16777619u;
+    }
+    return hash;
+}
+
+bool ScoreStore::validate() const {
+    if (file.size() < sizeof(StoreHeader)) return false;
+
+    const StoreHeader* h = header();
+    if (memcmp(h->magic, STORE_MAGIC, sizeof(STORE_MAGIC)) != 0 || h->version != VERSION) return false;
+    if (h->recordCapacity == 0 || h->recordCount > h->recordCapacity) return false;
+    if (h->hashCapacity != 2 * h->recordCapacity || (h->hashCapacity & (h->hashCapacity - 1)) != 0) return false;
+    return file.size() >= fileSize(h->recordCapacity);
+}
+
+uint32_t* ScoreStore::findSlot(const char* name, size_t length, uint32_t hash) const {
+    uint32_t* table = slots();
+    const StoreRecord* stored = records();
+    uint32_t mask = header()->hashCapacity - 1;
+    uint32_t count = header()->recordCount;
+
+    // Popunjenost je najvise 50%, pa prazan slot uvek postoji
+    for (uint32_t i = hash & mask; ; i = (i + 1) & mask) {
+        uint32_t value = table[i];
+        // Slot koji pokazuje iza recordCount je ostao od prekinutog upisa - smatra se praznim
+        if (value == 0 || value > count) return &table[i];
+
+        const StoreRecord& record = stored[value - 1];
+        if (record.nameLength == length && memcmp(record.name, name, length) == 0) return &table[i];
+    }
+}
+
+// Pravi nov fajl sa zadatim kapacitetom (i postojecim zapisima), pa ga atomski postavlja na mesto starog
+bool ScoreStore::rebuild(uint32_t recordCapacity) {
+    std::string tempPath = filePath + ".tmp";
+    remove(tempPath.c_str());
+
+    MappedFile target;
+    if (!target.open(tempPath, fileSize(recordCapacity))) return false;
+    memset(target.data(), 0, target.size());
+
+    StoreHeader* targetHeader = reinterpret_cast<StoreHeader*>(target.data());
+    StoreRecord* targetRecords = reinterpret_cast<StoreRecord*>(target.data() + sizeof(StoreHeader));
+    uint32_t* targetSlots = reinterpret_cast<uint32_t*>(target.data() + sizeof(StoreHeader) + recordCapacity * sizeof(StoreRecord));
+
+    uint32_t count = file.isOpen() ? header()->recordCount : 0;
+    if (count > 0) {
+        memcpy(targetRecords, records(), count * sizeof(StoreRecord));
+    }
+
+    uint32_t mask = 2 * recordCapacity - 1;
+    for (uint32_t r = 0; r < count; r++) {
+        uint32_t i = hashName(targetRecords[r].name, targetRecords[r].nameLength) & mask;
+        while (targetSlots[i] != 0) {
+            i = (i + 1) & mask;
+        }
+        targetSlots[i] = r + 1;
+    }
+
+    memcpy(targetHeader->magic, STORE_MAGIC, sizeof(STORE_MAGIC));
+    targetHeader->version = VERSION;
+    targetHeader->recordCount = count;
+    targetHeader->recordCapacity = recordCapacity;
+    targetHeader->hashCapacity = 2 * recordCapacity;
+
+    target.flush(true);
+    target.close();
+    file.close();
+
+    if (!replaceFile(tempPath, filePath)) {
+        std::cerr << "Ne mogu da zamenim fajl: " << filePath << std::endl;
+        remove(tempPath.c_str());
+        file.open(filePath, 0);
+        return false;
+    }
+    return file.open(filePath, 0) && validate();
+}
+
+bool ScoreStore::open(const std::string& path, const std::string& csvImportPath) {
+    close();
+    filePath = path;
+
+    if (fileExists(path)) {
+        if (file.open(path, 0) && validate()) {
+            std::cout << "Ucitano " << size() << " rezultata iz " << path << std::endl;
+            return true;
+        }
+
+        // Neispravan fajl se ostavlja sa strane, a rezultati se ponovo uvoze
+        file.close();
+        std::string badPath = path + ".bad";
+        std::cerr << "Neispravan fajl rezultata, premesten u: " << badPath << std::endl;
+        replaceFile(path, badPath);
+    }
+
+    if (!rebuild(INITIAL_CAPACITY)) {
+        std::cerr << "Ne mogu da napravim fajl rezultata: " << path << std::endl;
+        return false;
+    }
+    if (!csvImportPath.empty() && fileExists(csvImportPath)) {
+        long long imported = importCsv(csvImportPath);
+        flush(true);
+        std::cout << "Uvezeno " << imported << " rezultata iz " << csvImportPath << std::endl;
+    }
+    return true;
+}
+
+void ScoreStore::close() {
+    file.close();
+}
+
+long long ScoreStore::importCsv(const std::string& csvPath, MergeRule rule, long long* bytesRead) {
+    CsvReader reader;
+    if (!reader.open(csvPath)) return -1;
+
+    // Imena pokazuju u bafer citaca, pa se kopiraju u grupu pre sledeceg citanja
+    const size_t BATCH_SIZE = 1024;
+    std::vector<ScoreRecord> batch(BATCH_SIZE);
+    size_t used = 0;
+    long long imported = 0;
+
+    const char* name;
+    size_t nameLength;
+    int score;
+    while (true) {
+        bool more = reader.next(name, nameLength, score);
+        if (more) {
+            ScoreRecord& record = batch[used++];
+            if (nameLength > ScoreRecord::MAX_NAME_LENGTH) nameLength = ScoreRecord::MAX_NAME_LENGTH;
+            memcpy(record.name, name, nameLength);
+            record.name[nameLength] = '\0';
+            record.score = score;
+            record.timestampMs = 0;
+        }
+        if (used == BATCH_SIZE || (!more && used > 0)) {
+            if (!upsertBatch(batch.data(), used, rule)) return -1;
+            imported += static_cast<long long>(used);
+            used = 0;
+        }
+        if (!more) break;
+    }
+
+    if (bytesRead) *bytesRead = reader.getBytesRead();
+    if (reader.getSkippedLines() > 0) {
+        std::cout << csvPath << ": preskoceno neispravnih linija: " << reader.getSkippedLines() << std::endl;
+    }
+    return imported;
+}
+
+bool ScoreStore::get(const std::string& name, int& score) const {
+    if (!file.isOpen()) return false;
+
+    uint32_t value = *findSlot(name.c_str(), name.size(), hashName(name.c_str(), name.size()));
+    if (value == 0 || value > header()->recordCount) return false;
+
+    score = records()[value - 1].score;
+    return true;
+}
+
+bool ScoreStore::upsert(const char* name, int score, long long timestampMs) {
+    return upsert(name, strlen(name), score, timestampMs, MERGE_LATEST);
+}
+
+bool ScoreStore::upsert(const char* name, size_t length, int score, long long timestampMs, MergeRule rule) {
+    if (!file.isOpen()) return false;
+    if (length > ScoreRecord::MAX_NAME_LENGTH) length = ScoreRecord::MAX_NAME_LENGTH;
+
+    return upsertHashed(name, length, hashName(name, length), score, timestampMs, rule);
+}
+
+bool ScoreStore::upsertBatch(const ScoreRecord* batch, size_t count, MergeRule rule) {
+    if (!file.isOpen()) return false;
+
+    std::vector<uint32_t> hashes(count);
+    std::vector<size_t> lengths(count);
+    for (size_t i = 0; i < count; i++) {
+        lengths[i] = strlen(batch[i].name);
+        hashes[i] = hashName(batch[i].name, lengths[i]);
+    }
+
+    // Protocna obrada: slot se ucitava PREFETCH_DISTANCE koraka ranije, a zapis na koji pokazuje
+    // upola ranije (slot je do tada vec stigao). Prefetch je samo nagovestaj - upis ide redom.
+    for (size_t i = 0; i < count + PREFETCH_DISTANCE; i++) {
+        uint32_t* table = slots();
+        uint32_t mask = header()->hashCapacity - 1;
+
+        if (i < count) {
+            PREFETCH(&table[hashes[i] & mask]);
+        }
+        if (i >= PREFETCH_DISTANCE / 2 && i - PREFETCH_DISTANCE / 2 < count) {
+            uint32_t value = table[hashes[i - PREFETCH_DISTANCE / 2] & mask];
+            if (value != 0 && value <= header()->recordCount) PREFETCH(&records()[value - 1]);
+        }
+        if (i >= PREFETCH_DISTANCE) {
+            size_t current = i - PREFETCH_DISTANCE;
+            const ScoreRecord& record = batch[current];
+            if (!upsertHashed(record.name, lengths[current], hashes[current], record.score, record.timestampMs, rule)) return false;
+        }
+    }
+    return true;
+}
+
+bool ScoreStore::upsertHashed(const char* name, size_t length, uint32_t hash, int score, long long timestampMs, MergeRule rule) {
+    uint32_t* slot = findSlot(name, length, hash);
+    uint32_t count = header()->recordCount;
+    if (*slot != 0 && *slot <= count) {
+        // Postojeci igrac - izmena na mestu
+        StoreRecord& record = records()[*slot - 1];
+        if (rule == MERGE_BEST && record.score >= score) return true;
+        record.score = score;
+        record.timestampMs = timestampMs;
+        return true;
+    }
+
+    if (count == header()->recordCapacity) {
+        if (!rebuild(header()->recordCapacity * 2)) return false;
+        slot = findSlot(name, length, hash);
+    }
+
+    // Redosled: zapis, slot, pa brojac - prekid u sredini ostavlja samo zapis/slot koji se ignorisu
+    StoreRecord& record = records()[count];
+    memset(&record, 0, sizeof(record));
+    record.nameLength = static_cast<uint8_t>(length);
+    memcpy(record.name, name, length);
+    record.score = score;
+    record.timestampMs = timestampMs;
+
+    *slot = count + 1;
+    header()->recordCount = count + 1;
+    return true;
+}
+
+bool ScoreStore::flush(bool sync) {
+    return file.flush(sync);
+}
@@ -0,0 +1,139 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../Header/ScoreTool.h"
+#include "../Header/FileUtil.h"
+#include "../Header/RunHistory.h"
+#include "../Header/ScoreJournal.h"
+#include "../Header/ScoreStore.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+typedef std::chrono::steady_clock ToolClock;
+
+static double elapsedSeconds(ToolClock::time_point start) {
+    return std::chrono::duration<double>(ToolClock::now() - start).count();
+}
+
+static void reportThroughput(const char* action, const std::string& path, long long lines, long long bytes, double seconds) {
+    printf("%s %s: %lld linija, %.1f MB za %.3f s (%.0f MB/s)\n", action, path.c_str(), lines,
+        bytes / 1e6, seconds, seconds > 0.0 ? bytes / 1e6 / seconds : 0.0);
+}
+
+static bool importFile(ScoreStore& store, const std::string& path, ScoreStore::MergeRule rule) {
+    ToolClock::time_point start = ToolClock::now();
+    long long bytes = 0;
+    long long lines = store.importCsv(path, rule, &bytes);
+    if (lines < 0) {
+        std::cerr << "Uvoz nije uspeo: " << path << std::endl;
+        return false;
+    }
+
+    reportThroughput("Uvoz", path, lines, bytes, elapsedSeconds(start));
+    return true;
+}
+
+// Upis u privremeni fajl kroz bafer od 1 MB, pa atomska zamena
+static bool exportFile(const ScoreStore& store, const std::string& path) {
+    std::string tempPath = path + ".tmp";
+    FILE* output = fopen(tempPath.c_str(), "wb");
+    if (!output) {
+        std::cerr << "Ne mogu da upisem fajl: " << tempPath << std::endl;
+        return false;
+    }
+
+    ToolClock::time_point start = ToolClock::now();
+    std::vector<char> buffer(1 << 20);
+    size_t used = 0;
+    long long bytes = 0;
+    bool ok = true;
+
+    store.forEachRecord([&](const ScoreStore::StoreRecord& record) {
+        // Ime + ',' + najvise 11 znakova skora + '\n'
+        if (used + ScoreRecord::MAX_NAME_LENGTH + 13 > buffer.size()) {
+            if (fwrite(buffer.data(), 1, used, output) != used) ok = false;
+            bytes += used;
+            used = 0;
+        }
+
+        char* out = buffer.data() + used;
+        memcpy(out, record.name, record.nameLength);
+        out += record.nameLength;
+        *out++ = ',';
+
+        long long value = record.score;
+        if (value < 0) {
+            *out++ = '-';
+            value = -value;
+        }
+        char digits[12];
+        int count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        while (count > 0) {
+            *out++ = digits[--count];
+        }
+        *out++ = '\n';
+
+        used = out - buffer.data();
+    });
+
+    if (used > 0 && fwrite(buffer.data(), 1, used, output) != used) ok = false;
+    bytes += used;
+    syncFile(output);
+    if (fclose(output) != 0) ok = false;
+
+    if (!ok || !replaceFile(tempPath, path)) {
+        std::cerr << "Ne mogu da upisem fajl: " << path << std::endl;
+        remove(tempPath.c_str());
+        return false;
+    }
+
+    reportThroughput("Izvoz", path, static_cast<long long>(store.size()), bytes, elapsedSeconds(start));
+    return true;
+}
+
+int runScoreTool(const Options& options) {
+    ScoreStore store;
+    if (!store.open(options.scoreStorePath, "")) return -1;
+
+    // Rezultati iz dnevnika igre se prvo prenose u skladiste
+    std::string journalPath = journalPathForStore(options.scoreStorePath);
+    if (fileExists(journalPath) || fileExists(journalPath + ".old")) {
+        ScoreJournal journal(store, journalPath);
+        if (!journal.compact()) return -1;
+    }
+
+    ScoreStore::MergeRule rule = options.mergeBest ? ScoreStore::MERGE_BEST : ScoreStore::MERGE_LATEST;
+    for (const std::string& path : options.importScores) {
+        if (!importFile(store, path, rule)) return -1;
+    }
+    if (!store.flush(true)) {
+        std::cerr << "Ne mogu da upisem skladiste rezultata: " << options.scoreStorePath << std::endl;
+        return -1;
+    }
+    std::cout << "Skladiste " << options.scoreStorePath << ": " << store.size() << " igraca" << std::endl;
+
+    if (!options.exportScores.empty() && !exportFile(store, options.exportScores)) return -1;
+    return 0;
+}
+
+int runHistoryReport(const Options& options) {
+    const int TOP_COUNT = 20;
+    long long nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    long long sinceMs = nowMs - static_cast<long long>(options.runReportDays) * 24 * 60 * 60 * 1000;
+
+    ToolClock::time_point start = ToolClock::now();
+    std::vector<std::pair<std::string, int> > best;
+    if (!bestScoresSince(options.runHistoryPath, sinceMs, best)) return -1;
+
+    printf("Najbolji rezultati za poslednjih %d dana (%zu igraca, %.3f s):\n", options.runReportDays, best.size(), elapsedSeconds(start));
+    for (size_t i = 0; i < best.size() && i < static_cast<size_t>(TOP_COUNT); i++) {
+        printf("  %2zu. %-16s %d\n", i + 1, best[i].first.c_str(), best[i].second);
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../Header/StartupProfiler.h"
+#include <cstdio>
+#include <iostream>
+#include <iomanip>
+
+StartupProfiler::StartupProfiler()
+    : origin(std::chrono::steady_clock::now()), totalUs(0.0), finished(false)
+{
+}
+
+StartupProfiler& StartupProfiler::instance() {
+    static StartupProfiler profiler;
+    return profiler;
+}
+
+double StartupProfiler::nowUs() const {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - origin).count();
+}
+
+void StartupProfiler::begin(const std::string& name) {
+    if (finished) return;
+
+    Phase phase;
+    phase.name = name;
+    phase.startUs = nowUs();
+    phase.durationUs = 0.0;
+    phase.depth = static_cast<int>(openPhases.size());
+
+    openPhases.push_back(phases.size());
+    phases.push_back(phase);
+}
+
+void StartupProfiler::end() {
+    if (finished || openPhases.empty()) return;
+
+    Phase& phase = phases[openPhases.back()];
+    phase.durationUs = nowUs() - phase.startUs;
+    openPhases.pop_back();
+}
+
+void StartupProfiler::finish() {
+    if (finished) return;
+
+    // Zatvori faze koje su ostale otvorene (npr. rani return)
+    while (!openPhases.empty()) {
+        end();
+    }
+
+    totalUs = nowUs();
+    finished = true;
+}
+
+static void writeJsonString(FILE* file, const std::string& text) {
+    fputc('"', file);
+    for (char c : text) {
+        switch (c) {
+            case '"':  fputs("\\\"", file); break;
+            case '\\': fputs("\\\\", file); break;
+            case '\n': fputs("\\n", file); break;
+            case '\t': fputs("\\t", file); break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    fprintf(file, "\\u%04x", c);
+                }
+                else {
+                    fputc(c, file);
+                }
+        }
+    }
+    fputc('"', file);
+}
+
+bool StartupProfiler::writeChromeTrace(const char* filePath) const {
+    FILE* file = fopen(filePath, "w");
+    if (!file) {
+        std::cout << "Ne mogu da upisem startup trace: " << filePath << std::endl;
+        return false;
+    }
+
+    // "X" (complete) dogadjaji, vreme u mikrosekundama
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    fprintf(file, "{\"name\":\"startup\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":0,\"dur\":%.3f}", totalUs);
+    for (const Phase& phase : phases) {
+        fputs(",\n{\"name\":", file);
+        writeJsonString(file, phase.name);
+        fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}", phase.startUs, phase.durationUs);
+    }
+    fputs("\n]}\n", file);
+    fclose(file);
+
+    std::cout << "Startup trace upisan: " << filePath << std::endl;
+    return true;
+}
+
+void StartupProfiler::printSummary() const {
+    double total = totalUs > 0.0 ? totalUs : nowUs();
+
+    std::cout << "\n=== STARTUP PROFIL ===" << std::endl;
+    std::cout << std::left << std::setw(48) << "Faza"
+              << std::right << std::setw(12) << "Start ms"
+              << std::setw(12) << "Trajanje ms"
+              << std::setw(8) << "%" << std::endl;
+
+    for (const Phase& phase : phases) {
+        std::string label = std::string(phase.depth * 2, ' ') + phase.name;
+        if (label.size() > 47) label = label.substr(0, 44) + "...";
+
+        std::cout << std::left << std::setw(48) << label
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << phase.startUs / 1000.0
+                  << std::setw(12) << phase.durationUs / 1000.0
+                  << std::setw(7) << std::setprecision(1) << (100.0 * phase.durationUs / total) << "%"
+                  << std::endl;
+    }
+
+    std::cout << std::left << std::setw(48) << "UKUPNO"
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << 0.0
+              << std::setw(12) << total / 1000.0 << std::endl;
+    std::cout << std::defaultfloat;
+}
@@ -1,4 +1,5 @@
 #include "../Header/TextRenderer.h"
+#include "../Header/StartupProfiler.h"
 #include <iostream>
 
 TextRenderer::TextRenderer(unsigned int shader, int width, int height) 
@@ -28,6 +29,7 @@ TextRenderer::~TextRenderer() {
 }
 
 bool TextRenderer::loadFont(const char* fontPath, unsigned int fontSize) {
+    ProfileScope scope(std::string("loadFont: ") + fontPath);
     if (FT_New_Face(ft, fontPath, 0, &face)) {
         std::cout << "ERROR::FREETYPE: Failed to load font at: " << fontPath << std::endl;
         return false;
@@ -79,6 +81,10 @@ bool TextRenderer::loadFont(const char* fontPath, unsigned int fontSize) {
 }
 
 void TextRenderer::renderText(const std::string& text, float x, float y, float scale, float r, float g, float b) {
+    renderText(text.c_str(), x, y, scale, r, g, b);
+}
+
+void TextRenderer::renderText(const char* text, float x, float y, float scale, float r, float g, float b) {
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
@@ -100,8 +106,8 @@ void TextRenderer::renderText(const std::string& text, float x, float y, float s
     glActiveTexture(GL_TEXTURE0);
     glBindVertexArray(VAO);
 
-    for (char c : text) {
-        Character ch = Characters[c];
+    for (const char* p = text; *p != '\0'; p++) {
+        Character ch = Characters[*p];
 
         float xpos = x + ch.BearingX * scale;
         float ypos = y + (ch.SizeY - ch.BearingY) * scale;
@@ -133,9 +139,13 @@ void TextRenderer::renderText(const std::string& text, float x, float y, float s
 }
 
 float TextRenderer::getTextWidth(const std::string& text, float scale) {
+    return getTextWidth(text.c_str(), scale);
+}
+
+float TextRenderer::getTextWidth(const char* text, float scale) {
     float width = 0;
-    for (char c : text) {
-        Character ch = Characters[c];
+    for (const char* p = text; *p != '\0'; p++) {
+        Character ch = Characters[*p];
         width += (ch.Advance >> 6) * scale;
     }
     return width;
@@ -0,0 +1,215 @@
+#include "../Header/TextureManager.h"
+#include "../Header/Logger.h"
+#include "../Header/StartupProfiler.h"
+
+TextureManager::TextureManager(size_t budget)
+    : stopping(false), placeholderTexture(0), budgetBytes(budget), residentBytes(0), frame(0)
+{
+    // Providni 1x1 placeholder - ispod se vidi boja neba (glClearColor)
+    unsigned char transparent[4] = { 0, 0, 0, 0 };
+    glGenTextures(1, &placeholderTexture);
+    glBindTexture(GL_TEXTURE_2D, placeholderTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, transparent);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    worker = std::thread(&TextureManager::workerLoop, this);
+}
+
+TextureManager::~TextureManager() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    decodeReady.notify_all();
+    if (worker.joinable()) worker.join();
+
+    for (Entry& entry : entries) {
+        freeImagePixels(entry.pixels);
+        // Neuspela tekstura deli placeholder - on se brise jednom, ispod
+        if (entry.texture && entry.texture != placeholderTexture) glDeleteTextures(1, &entry.texture);
+    }
+    glDeleteTextures(1, &placeholderTexture);
+}
+
+int TextureManager::registerTexture(const std::string& path, int maxWidth, int maxHeight, GLint wrapS, GLint wrapT) {
+    Entry entry;
+    entry.path = path;
+    entry.maxWidth = maxWidth;
+    entry.maxHeight = maxHeight;
+    entry.wrapS = wrapS;
+    entry.wrapT = wrapT;
+    entry.pinned = false;
+    entry.state = UNLOADED;
+    entry.pixels.data = nullptr;
+    entry.texture = 0;
+    entry.bytes = 0;
+    entry.lastUsedFrame = 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.push_back(entry);
+    return static_cast<int>(entries.size()) - 1;
+}
+
+void TextureManager::requestLocked(int handle) {
+    Entry& entry = entries[handle];
+    if (entry.state != UNLOADED) return;
+
+    entry.state = QUEUED;
+    decodeQueue.push_back(handle);
+    decodeReady.notify_one();
+}
+
+unsigned int TextureManager::get(int handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry& entry = entries[handle];
+    entry.lastUsedFrame = frame;
+
+    if (entry.state == RESIDENT) return entry.texture;
+
+    requestLocked(handle);
+    return placeholderTexture;
+}
+
+void TextureManager::prefetch(int handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    requestLocked(handle);
+}
+
+void TextureManager::loadNow(int handle) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (entries[handle].state == RESIDENT) return;
+
+    ProfileScope scope(std::string("texture: ") + entries[handle].path);
+
+    if (entries[handle].state == UNLOADED) {
+        // Dekodiraj na ovoj niti; worker ce preskociti unos jer vise nije QUEUED
+        entries[handle].state = DECODED;
+        std::string path = entries[handle].path;
+        int maxWidth = entries[handle].maxWidth;
+        int maxHeight = entries[handle].maxHeight;
+
+        lock.unlock();
+        ImagePixels pixels;
+        if (!loadImagePixels(path.c_str(), maxWidth, maxHeight, pixels)) {
+            pixels.data = nullptr;
+        }
+        lock.lock();
+        entries[handle].pixels = pixels;
+    }
+    else {
+        // Vec je na dekodiranju - sacekaj worker
+        decodeReady.wait(lock, [this, handle] { return entries[handle].state == DECODED; });
+    }
+
+    entries[handle].lastUsedFrame = frame;
+    upload(entries[handle]);
+}
+
+void TextureManager::setPinned(int handle, bool pinned) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries[handle].pinned = pinned;
+}
+
+bool TextureManager::isResident(int handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries[handle].state == RESIDENT;
+}
+
+void TextureManager::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        decodeReady.wait(lock, [this] { return stopping || !decodeQueue.empty(); });
+        if (stopping) return;
+
+        int handle = decodeQueue.front();
+        decodeQueue.pop_front();
+        if (entries[handle].state != QUEUED) continue;
+
+        // Kopije parametara - vektor se moze realocirati dok je mutex otpusten
+        std::string path = entries[handle].path;
+        int maxWidth = entries[handle].maxWidth;
+        int maxHeight = entries[handle].maxHeight;
+
+        lock.unlock();
+        ImagePixels pixels;
+        if (!loadImagePixels(path.c_str(), maxWidth, maxHeight, pixels)) {
+            pixels.data = nullptr;
+        }
+        lock.lock();
+
+        entries[handle].pixels = pixels;
+        entries[handle].state = DECODED;
+        decodeReady.notify_all();
+    }
+}
+
+// Poziva se sa zakljucanim mutex-om, na OpenGL niti
+void TextureManager::upload(Entry& entry) {
+    if (!entry.pixels.data) {
+        // Neuspelo dekodiranje - ostaje placeholder, ne pokusava ponovo
+        LOG_ERROR("Tekstura nije ucitana: %s", entry.path.c_str());
+        entry.state = RESIDENT;
+        entry.texture = placeholderTexture;
+        entry.bytes = 0;
+        entry.pinned = true;
+        return;
+    }
+
+    entry.texture = uploadImageToTexture(entry.pixels);
+    glBindTexture(GL_TEXTURE_2D, entry.texture);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, entry.wrapS);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, entry.wrapT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Mipmape dodaju ~1/3
+    entry.bytes = (size_t)entry.pixels.width * entry.pixels.height * entry.pixels.channels * 4 / 3;
+    residentBytes += entry.bytes;
+    entry.state = RESIDENT;
+    freeImagePixels(entry.pixels);
+
+    LOG_INFO("Tekstura ucitana: %s, ID: %u (%zu KB rezidentno)", entry.path.c_str(), entry.texture, residentBytes / 1024);
+
+    evictOverBudget();
+}
+
+void TextureManager::evictOverBudget() {
+    while (residentBytes > budgetBytes) {
+        Entry* victim = nullptr;
+        for (Entry& entry : entries) {
+            // Tekstura crtana u ovom ili prethodnom frejmu se ne izbacuje - update() ide pre get()
+            if (entry.state != RESIDENT || entry.pinned || entry.bytes == 0 || entry.lastUsedFrame + 1 >= frame) continue;
+            if (!victim || entry.lastUsedFrame < victim->lastUsedFrame) victim = &entry;
+        }
+        if (!victim) return;
+
+        LOG_INFO("Tekstura izbacena (LRU): %s", victim->path.c_str());
+        glDeleteTextures(1, &victim->texture);
+        residentBytes -= victim->bytes;
+        victim->texture = 0;
+        victim->bytes = 0;
+        victim->state = UNLOADED;
+    }
+}
+
+void TextureManager::update(int maxUploads) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Ogranicen broj upload-a po frejmu da ne bi bilo zastoja
+    int uploads = 0;
+    for (Entry& entry : entries) {
+        if (uploads >= maxUploads) break;
+        if (entry.state != DECODED) continue;
+        upload(entry);
+        uploads++;
+    }
+}
+
+void TextureManager::endFrame() {
+    std::lock_guard<std::mutex> lock(mutex);
+    frame++;
+}
@@ -0,0 +1,121 @@
+#include "../Header/TowerStability.h"
+#include <algorithm>
+#include <cmath>
+
+// Prava mora da ostane u cvoru ciji interval je dobila pri dodavanju - zato domen ne sme da raste.
+// Masa je u milionitim delovima sirine: 2^50 jedinica je ~4e9 punih blokova.
+static const long long DOMAIN = 1LL << 50;
+static const double MASS_SCALE = 1e6;
+// Greska zaokruzivanja zbira raste sa ukupnom masom; teziste tacno na ivici se drzi
+static const double EDGE_TOLERANCE = 1e-10;
+
+void TowerStability::Envelope::reset() {
+    nodes.clear();
+    Node node = { { 0.0, 0.0, -1 }, -1, -1 };
+    nodes.push_back(node);
+}
+
+void TowerStability::Envelope::insert(double a, double b, long long floor) {
+    Line line = { a, b, floor };
+    int index = 0;
+    long long lo = 0, hi = DOMAIN;
+
+    while (true) {
+        Node& node = nodes[index];
+        if (node.line.floor < 0) {
+            node.line = line;
+            return;
+        }
+
+        // U cvoru ostaje prava koja je bolja na sredini; druga moze biti bolja samo na jednoj strani
+        long long mid = lo + (hi - lo) / 2;
+        bool betterLow = line.at(lo) > node.line.at(lo);
+        bool betterMid = line.at(mid) > node.line.at(mid);
+        if (betterMid) std::swap(node.line, line);
+        if (hi - lo == 1) return;
+
+        bool goLeft = betterLow != betterMid;
+        int child = goLeft ? node.left : node.right;
+        if (child < 0) {
+            Node created = { line, -1, -1 };
+            nodes.push_back(created);
+            // push_back moze da premesti niz - cvor se trazi ponovo po indeksu
+            if (goLeft) nodes[index].left = static_cast<int>(nodes.size() - 1);
+            else nodes[index].right = static_cast<int>(nodes.size() - 1);
+            return;
+        }
+        index = child;
+        if (goLeft) hi = mid;
+        else lo = mid;
+    }
+}
+
+double TowerStability::Envelope::query(long long x, long long& floor) const {
+    double best = -HUGE_VAL;
+    floor = -1;
+    int index = 0;
+    long long lo = 0, hi = DOMAIN;
+    while (index >= 0) {
+        const Node& node = nodes[index];
+        if (node.line.floor >= 0) {
+            double value = node.line.at(x);
+            if (value > best) {
+                best = value;
+                floor = node.line.floor;
+            }
+        }
+        long long mid = lo + (hi - lo) / 2;
+        if (x < mid) {
+            index = node.left;
+            hi = mid;
+        }
+        else {
+            index = node.right;
+            lo = mid;
+        }
+    }
+    return best;
+}
+
+void TowerStability::reset() {
+    leftEdges.reset();
+    rightEdges.reset();
+    sumX = 0.0;
+    totalMass = 0;
+    count = 0;
+    topLeft = topRight = 0.0f;
+}
+
+bool TowerStability::addBlock(float centerX, float width, long long& failedFloor) {
+    failedFloor = -1;
+    float left = centerX - width / 2.0f;
+    float right = centerX + width / 2.0f;
+
+    if (count > 0) {
+        // Sprat k = count lezi na spratu k-1; dodir je presek njihovih sirina
+        double contactLeft = std::max(left, topLeft);
+        double contactRight = std::min(right, topRight);
+        double mass = static_cast<double>(totalMass);
+        leftEdges.insert(contactLeft, sumX - contactLeft * mass, count);
+        rightEdges.insert(-contactRight, -(sumX - contactRight * mass), count);
+    }
+
+    long long mass = std::max(1LL, static_cast<long long>(llround(width * MASS_SCALE)));
+    sumX += static_cast<double>(mass) * centerX;
+    totalMass += mass;
+    count++;
+    topLeft = left;
+    topRight = right;
+
+    long long floor;
+    double tolerance = EDGE_TOLERANCE * static_cast<double>(totalMass);
+    if (sumX < leftEdges.query(totalMass, floor) - tolerance) {
+        failedFloor = floor;
+        return false;
+    }
+    if (-sumX < rightEdges.query(totalMass, floor) - tolerance) {
+        failedFloor = floor;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,93 @@
+#include "../Header/TowerSway.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TOWER_SWAY_SSE 1
+#include <xmmintrin.h>
+#endif
+
+static const float BASE_STIFFNESS = 600.0f;
+static const float OVERHANG_SOFTENING = 4.0f;     // k = BASE / (1 + SOFTENING * zbir prepustanja)
+static const float DAMPING_RATIO = 0.04f;         // Deo kriticnog prigusenja jedne opruge
+static const float STABLE_STEP = 1.0f;            // omega_max * dt (granica je 2)
+
+void TowerSway::reset() {
+    count = 0;
+    accumulatedOverhang = 0.0f;
+    maxStiffness = 0.0f;
+    peakTopOffset = 0.0f;
+    offset.assign(8, 0.0f);
+    velocity.assign(8, 0.0f);
+    stiffness.assign(8, 0.0f);
+    damping.assign(8, 0.0f);
+    force.assign(8, 0.0f);
+}
+
+// Mesto za sprat n (indeks n), grupu od 4 od njega i f_{n+1}
+void TowerSway::reserveFloors(size_t floors) {
+    size_t needed = floors + 8;
+    if (needed <= offset.size()) return;
+    size_t grown = std::max(needed, offset.size() * 2);
+    offset.resize(grown, 0.0f);
+    velocity.resize(grown, 0.0f);
+    stiffness.resize(grown, 0.0f);
+    damping.resize(grown, 0.0f);
+    force.resize(grown, 0.0f);
+}
+
+void TowerSway::addFloor(float overhangRatio) {
+    reserveFloors(count + 1);
+    accumulatedOverhang += std::max(0.0f, overhangRatio);
+    count++;
+    float k = BASE_STIFFNESS / (1.0f + OVERHANG_SOFTENING * accumulatedOverhang);
+    offset[count] = offset[count - 1];     // Nov sprat legne na trenutni polozaj vrha
+    velocity[count] = velocity[count - 1];
+    stiffness[count] = k;
+    damping[count] = DAMPING_RATIO * 2.0f * sqrtf(k);
+    maxStiffness = std::max(maxStiffness, k);
+}
+
+void TowerSway::kickTop(float deltaVelocity) {
+    if (count > 0) velocity[count] += deltaVelocity;
+}
+
+void TowerSway::step(float dt) {
+    if (count == 0 || dt <= 0.0f) return;
+    // Najvisa frekvencija lanca jedinicnih masa je najvise 2 * sqrt(k_max)
+    float omegaMax = 2.0f * sqrtf(maxStiffness);
+    int subSteps = std::max(1, static_cast<int>(ceilf(dt * omegaMax / STABLE_STEP)));
+    for (int i = 0; i < subSteps; i++) {
+        integrate(dt / subSteps);
+    }
+    peakTopOffset = std::max(peakTopOffset, fabsf(offset[count]));
+}
+
+// Iznad vrha su k = c = 0: sila f_{n+1} je 0, a ostatak poslednje grupe od 4 miruje
+void TowerSway::integrate(float dt) {
+#ifdef TOWER_SWAY_SSE
+    // 1. sila u svakoj opruzi (i-1 -> i)
+    for (size_t i = 1; i <= count; i += 4) {
+        __m128 stretch = _mm_sub_ps(_mm_loadu_ps(&offset[i]), _mm_loadu_ps(&offset[i - 1]));
+        __m128 rate = _mm_sub_ps(_mm_loadu_ps(&velocity[i]), _mm_loadu_ps(&velocity[i - 1]));
+        __m128 f = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&stiffness[i]), stretch), _mm_mul_ps(_mm_loadu_ps(&damping[i]), rate));
+        _mm_storeu_ps(&force[i], f);
+    }
+    // 2. brzina pa polozaj (simplekticki)
+    const __m128 dtVector = _mm_set1_ps(dt);
+    for (size_t i = 1; i <= count; i += 4) {
+        __m128 acceleration = _mm_sub_ps(_mm_loadu_ps(&force[i + 1]), _mm_loadu_ps(&force[i]));
+        __m128 v = _mm_add_ps(_mm_loadu_ps(&velocity[i]), _mm_mul_ps(acceleration, dtVector));
+        _mm_storeu_ps(&velocity[i], v);
+        _mm_storeu_ps(&offset[i], _mm_add_ps(_mm_loadu_ps(&offset[i]), _mm_mul_ps(v, dtVector)));
+    }
+#else
+    for (size_t i = 1; i <= count; i++) {
+        force[i] = stiffness[i] * (offset[i] - offset[i - 1]) + damping[i] * (velocity[i] - velocity[i - 1]);
+    }
+    for (size_t i = 1; i <= count; i++) {
+        velocity[i] += (force[i + 1] - force[i]) * dt;
+        offset[i] += velocity[i] * dt;
+    }
+#endif
+}
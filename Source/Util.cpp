@@ -1,9 +1,13 @@
 #include "../Header/Util.h";
+#include "../Header/StartupProfiler.h"
 
 #define _CRT_SECURE_NO_WARNINGS
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "../Header/stb_image.h"
@@ -61,6 +65,7 @@ unsigned int compileShader(GLenum type, const char* source)
 unsigned int createShader(const char* vsSource, const char* fsSource)
 {
     //Pravi objedinjeni sejder program koji se sastoji od Vertex sejdera ciji je kod na putanji vsSource
+    ProfileScope scope(std::string("createShader: ") + vsSource);
 
     unsigned int program; //Objedinjeni sejder
     unsigned int vertexShader; //Verteks sejder (za prostorne podatke)
@@ -97,50 +102,167 @@ unsigned int createShader(const char* vsSource, const char* fsSource)
     return program;
 }
 
-unsigned loadImageToTexture(const char* filePath) {
-    int TextureWidth;
-    int TextureHeight;
-    int TextureChannels;
-    
-    // ? Postavi automatsko flip-ovanje slike
-    stbi_set_flip_vertically_on_load(true);
-    
-    unsigned char* ImageData = stbi_load(filePath, &TextureWidth, &TextureHeight, &TextureChannels, 0);
-    
-    if (ImageData != NULL)
-    {
-        std::cout << "? U?itana tekstura: " << filePath 
-                  << " (" << TextureWidth << "x" << TextureHeight 
-                  << ", " << TextureChannels << " kanala)" << std::endl;
-        
-        // Provjerava koji je format boja ucitane slike
-        GLint InternalFormat = GL_RGB;
-        switch (TextureChannels) {
-            case 1: InternalFormat = GL_RED; break;
-            case 2: InternalFormat = GL_RG; break;
-            case 3: InternalFormat = GL_RGB; break;
-            case 4: InternalFormat = GL_RGBA; break;
+// Box (area) filter: svaki izlazni piksel je prosek izvornih piksela koje pokriva,
+// sa delimicnim tezinama na ivicama. Tezine se racunaju jednom po osi.
+static void buildBoxWeights(int srcSize, int dstSize, std::vector<int>& first, std::vector<float>& weights, int& taps)
+{
+    float scale = (float)srcSize / (float)dstSize;
+    taps = (int)ceil(scale) + 1;
+
+    first.assign(dstSize, 0);
+    weights.assign((size_t)dstSize * taps, 0.0f);
+
+    for (int i = 0; i < dstSize; i++) {
+        float start = i * scale;
+        float end = start + scale;
+        int j0 = (int)floor(start);
+        first[i] = j0;
+
+        for (int t = 0; t < taps; t++) {
+            int j = j0 + t;
+            if (j >= srcSize) break;
+            float overlap = std::min(end, (float)(j + 1)) - std::max(start, (float)j);
+            if (overlap > 0.0f) {
+                weights[(size_t)i * taps + t] = overlap / scale;
+            }
+        }
+    }
+}
+
+static unsigned char* downscaleImage(const unsigned char* src, int srcWidth, int srcHeight, int channels,
+                                     int dstWidth, int dstHeight)
+{
+    std::vector<int> firstX, firstY;
+    std::vector<float> weightsX, weightsY;
+    int tapsX, tapsY;
+    buildBoxWeights(srcWidth, dstWidth, firstX, weightsX, tapsX);
+    buildBoxWeights(srcHeight, dstHeight, firstY, weightsY, tapsY);
+
+    unsigned char* dst = (unsigned char*)STBI_MALLOC((size_t)dstWidth * dstHeight * channels);
+    if (!dst) return NULL;
+
+    const int srcRowLength = srcWidth * channels;
+    std::vector<float> row(srcRowLength);
+
+    for (int y = 0; y < dstHeight; y++) {
+        // Vertikalni prolaz - cele izvorne linije, kontinualna petlja koju kompajler vektorizuje
+        std::fill(row.begin(), row.end(), 0.0f);
+        const float* wy = &weightsY[(size_t)y * tapsY];
+        for (int t = 0; t < tapsY; t++) {
+            float w = wy[t];
+            if (w == 0.0f) continue;
+            const unsigned char* srcRow = src + (size_t)(firstY[y] + t) * srcRowLength;
+            float* acc = row.data();
+            for (int k = 0; k < srcRowLength; k++) {
+                acc[k] += w * srcRow[k];
+            }
         }
 
-        unsigned int Texture;
-        glGenTextures(1, &Texture);
-        glBindTexture(GL_TEXTURE_2D, Texture);
-        glTexImage2D(GL_TEXTURE_2D, 0, InternalFormat, TextureWidth, TextureHeight, 
-                     0, InternalFormat, GL_UNSIGNED_BYTE, ImageData);
-        glBindTexture(GL_TEXTURE_2D, 0);
-        
-        // oslobadjanje memorije zauzete sa stbi_load posto vise nije potrebna
-        stbi_image_free(ImageData);
-        
-        std::cout << "? Tekstura kreirana, ID: " << Texture << std::endl;
-        return Texture;
+        // Horizontalni prolaz nad jednom (vec smanjenom) linijom
+        unsigned char* dstRow = dst + (size_t)y * dstWidth * channels;
+        for (int x = 0; x < dstWidth; x++) {
+            const float* wx = &weightsX[(size_t)x * tapsX];
+            const float* srcPixel = &row[(size_t)firstX[x] * channels];
+            for (int c = 0; c < channels; c++) {
+                float sum = 0.0f;
+                for (int t = 0; t < tapsX && firstX[x] + t < srcWidth; t++) {
+                    sum += wx[t] * srcPixel[t * channels + c];
+                }
+                int value = (int)(sum + 0.5f);
+                dstRow[x * channels + c] = (unsigned char)(value > 255 ? 255 : value);
+            }
+        }
     }
-    else
+    return dst;
+}
+
+bool loadImagePixels(const char* filePath, int maxWidth, int maxHeight, ImagePixels& image)
+{
+    image.data = NULL;
+    image.width = image.height = image.channels = 0;
+
+    stbi_set_flip_vertically_on_load_thread(true);
+
+    int sourceWidth, sourceHeight, channels;
+    unsigned char* data = stbi_load(filePath, &sourceWidth, &sourceHeight, &channels, 0);
+    if (data == NULL)
     {
         std::cout << "? Greka: Tekstura nije u?itana: " << filePath << std::endl;
         std::cout << "   Razlog: " << stbi_failure_reason() << std::endl;
+        return false;
+    }
+
+    // Smanji samo ako je slika veca od najvece velicine na ekranu (nikad ne uvecavaj)
+    int targetWidth = (maxWidth > 0 && maxWidth < sourceWidth) ? maxWidth : sourceWidth;
+    int targetHeight = (maxHeight > 0 && maxHeight < sourceHeight) ? maxHeight : sourceHeight;
+
+    if (targetWidth != sourceWidth || targetHeight != sourceHeight) {
+        unsigned char* resized = downscaleImage(data, sourceWidth, sourceHeight, channels, targetWidth, targetHeight);
+        if (resized) {
+            std::cout << "? Smanjena tekstura: " << filePath << " (" << sourceWidth << "x" << sourceHeight
+                      << " -> " << targetWidth << "x" << targetHeight << ")" << std::endl;
+            stbi_image_free(data);
+            data = resized;
+        }
+        else {
+            targetWidth = sourceWidth;
+            targetHeight = sourceHeight;
+        }
+    }
+
+    image.data = data;
+    image.width = targetWidth;
+    image.height = targetHeight;
+    image.channels = channels;
+    return true;
+}
+
+void freeImagePixels(ImagePixels& image)
+{
+    if (image.data) stbi_image_free(image.data);
+    image.data = NULL;
+}
+
+unsigned uploadImageToTexture(const ImagePixels& image)
+{
+    // Provjerava koji je format boja ucitane slike
+    GLint InternalFormat = GL_RGB;
+    switch (image.channels) {
+        case 1: InternalFormat = GL_RED; break;
+        case 2: InternalFormat = GL_RG; break;
+        case 3: InternalFormat = GL_RGB; break;
+        case 4: InternalFormat = GL_RGBA; break;
+    }
+
+    // Smanjene slike nemaju poravnate linije na 4 bajta
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    unsigned int Texture;
+    glGenTextures(1, &Texture);
+    glBindTexture(GL_TEXTURE_2D, Texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, InternalFormat, image.width, image.height,
+                 0, InternalFormat, GL_UNSIGNED_BYTE, image.data);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return Texture;
+}
+
+unsigned loadImageToTexture(const char* filePath, int maxWidth, int maxHeight) {
+    ImagePixels image;
+    if (!loadImagePixels(filePath, maxWidth, maxHeight, image)) {
         return 0;
     }
+
+    std::cout << "? U?itana tekstura: " << filePath
+              << " (" << image.width << "x" << image.height
+              << ", " << image.channels << " kanala)" << std::endl;
+
+    unsigned int Texture = uploadImageToTexture(image);
+
+    // oslobadjanje memorije zauzete sa stbi_load posto vise nije potrebna
+    freeImagePixels(image);
+
+    std::cout << "? Tekstura kreirana, ID: " << Texture << std::endl;
+    return Texture;
 }
 
 GLFWcursor* loadImageToCursor(const char* filePath) {